@@ -378,7 +378,24 @@ if [ ! -d $BUILD_SRC/sst-elements ] || [ ! -d $BUILD_DEST/sst-elements ]; then
     git clone -b $SST_ELEMENTS_BRANCH --single-branch $SST_ELEMENTS_GIT $BUILD_SRC/sst-elements
 
     ### This line is because of a Golem problem. A pull request is in order.
-    cp $UTILS_DIR/sst-elements/crossSimComputeArray.h $BUILD_SRC/sst-elements/src/sst/elements/golem/array/.
+    GOLEM_SRC=$BUILD_SRC/sst-elements/src/sst/elements/golem
+    cp $UTILS_DIR/sst-elements/crossSimComputeArray.h $GOLEM_SRC/array/.
+    cp $UTILS_DIR/sst-elements/crossSimPolicies.h $GOLEM_SRC/array/.
+    cp $UTILS_DIR/sst-elements/analogTileEvent.h $GOLEM_SRC/array/.
+    cp $UTILS_DIR/sst-elements/sharedAnalogTile.h $GOLEM_SRC/array/.
+    cp $UTILS_DIR/sst-elements/sharedAnalogTile.cc $GOLEM_SRC/array/.
+    cp $UTILS_DIR/sst-elements/analogArrayOps.h $GOLEM_SRC/array/.
+    # RoCC front-end (tile port, func7 0x6-0xE); it includes the shared headers
+    # from its own directory
+    cp $UTILS_DIR/sst-elements/newrocc.h $GOLEM_SRC/rocc/roccAnalog.h
+    cp $UTILS_DIR/sst-elements/analogTileEvent.h $GOLEM_SRC/rocc/.
+    cp $UTILS_DIR/sst-elements/analogArrayOps.h $GOLEM_SRC/rocc/.
+    # The shared tile is a component of its own and needs a compiled unit
+    GOLEM_SOURCES=$(grep -o '^lib[A-Za-z_]*_la_SOURCES' $GOLEM_SRC/Makefile.am | head -1)
+    if ! grep -q 'array/sharedAnalogTile.cc' $GOLEM_SRC/Makefile.am; then
+        printf '\n%s += \\\n\tarray/sharedAnalogTile.cc \\\n\tarray/sharedAnalogTile.h \\\n\tarray/analogTileEvent.h \\\n\tarray/analogArrayOps.h \\\n\tarray/crossSimPolicies.h\n' \
+            "$GOLEM_SOURCES" >> $GOLEM_SRC/Makefile.am
+    fi
     ###
 
     pushd $BUILD_SRC/sst-elements
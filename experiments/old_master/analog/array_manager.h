@@ -0,0 +1,94 @@
+// analog/array_manager.h: which tile is resident in which array of one core.
+//
+// An AnalogMatrix whose tiles outnumber a core's arrays keeps a host copy of
+// them; acquire() reprograms a victim array with mvm.set on a miss. Victims
+// are picked least-recently-used, or least-frequently-used since they were
+// loaded (ties broken LRU). One manager per core, touched only by its thread.
+
+#ifndef ANALOG_ARRAY_MANAGER_H
+#define ANALOG_ARRAY_MANAGER_H
+
+#include <cstdint>
+#include <vector>
+
+namespace analog {
+
+enum class Replacement { LRU, LFU };
+
+struct ResidencyStats {
+    uint64_t hits       = 0;   // tile already on an array
+    uint64_t misses     = 0;   // tile had to be programmed
+    uint64_t reprograms = 0;   // ... over another resident tile
+
+    ResidencyStats& operator+=(const ResidencyStats& o) {
+        hits += o.hits; misses += o.misses; reprograms += o.reprograms;
+        return *this;
+    }
+};
+
+class ArrayManager {
+public:
+    void init(const std::vector<int>& arrays, Replacement policy) {
+        arrays_ = arrays;
+        policy_ = policy;
+        holder_.assign(arrays.size(), nullptr);
+        last_.assign(arrays.size(), 0);
+        uses_.assign(arrays.size(), 0);
+    }
+
+    int capacity() const { return static_cast<int>(arrays_.size()); }
+    const std::vector<int>& arrays() const { return arrays_; }
+
+    // Array holding the tile whose residency is tracked in `slot` (-1 = not
+    // resident). On a miss program(array_id) must issue the mvm.set.
+    template <typename Program>
+    int acquire(int& slot, Program&& program) {
+        ++clock_;
+        if (slot >= 0) {
+            ++stats_.hits;
+            last_[slot] = clock_;
+            ++uses_[slot];
+            return arrays_[slot];
+        }
+        ++stats_.misses;
+        const int v = victim();
+        if (holder_[v]) {
+            *holder_[v] = -1;
+            ++stats_.reprograms;
+        }
+        holder_[v] = &slot;
+        slot = v;
+        last_[v] = clock_;
+        uses_[v] = 1;
+        program(arrays_[v]);
+        return arrays_[v];
+    }
+
+    const ResidencyStats& stats() const { return stats_; }
+    void reset_stats() { stats_ = ResidencyStats(); }
+
+private:
+    int victim() const {
+        int v = 0;
+        for (int s = 0; s < capacity(); ++s) {
+            if (!holder_[s]) return s;
+            const bool better = policy_ == Replacement::LFU
+                ? (uses_[s] < uses_[v] || (uses_[s] == uses_[v] && last_[s] < last_[v]))
+                : last_[s] < last_[v];
+            if (better) v = s;
+        }
+        return v;
+    }
+
+    std::vector<int>      arrays_;
+    std::vector<int*>     holder_;   // residency field of the tile in each array
+    std::vector<uint64_t> last_;
+    std::vector<uint64_t> uses_;
+    uint64_t              clock_ = 0;
+    Replacement           policy_ = Replacement::LRU;
+    ResidencyStats        stats_;
+};
+
+} // namespace analog
+
+#endif // ANALOG_ARRAY_MANAGER_H
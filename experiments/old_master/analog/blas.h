@@ -0,0 +1,62 @@
+// analog/blas.h: BLAS-style entry points over AnalogMatrix.
+//
+// The matrix operand is an AnalogMatrix already programmed on the arrays, so
+// the usual A/lda arguments collapse into it. Vectors are dense (incx = 1).
+
+#ifndef ANALOG_BLAS_H
+#define ANALOG_BLAS_H
+
+#include "analog/matrix.h"
+#include "analog/complex.h"
+
+namespace analog {
+
+enum class Trans { N, T };
+
+// y = alpha*op(A)*x + beta*y
+static inline void gemv(Trans trans, real alpha, AnalogMatrix& A, const real* x, real beta, real* y) {
+    if (trans == Trans::N) A.gemv(x, y, alpha, beta);
+    else                   A.gemv_t(x, y, alpha, beta);
+}
+
+// C = alpha*A*B + beta*C with B (cols x k) and C (rows x k) column-major
+static inline void gemm(int k, real alpha, AnalogMatrix& A, const real* B, int ldb,
+                        real beta, real* C, int ldc) {
+    A.gemm(B, k, ldb, C, ldc, alpha, beta);
+}
+
+typedef std::complex<float>  cfloat;
+typedef std::complex<double> zdouble;
+
+// y = alpha*op(A)*x + beta*y, complex
+template <typename F>
+static inline void xgemv(Trans trans, std::complex<F> alpha, ComplexAnalogMatrix& A,
+                         const std::complex<F>* x, std::complex<F> beta, std::complex<F>* y) {
+    if (trans == Trans::N) A.gemv(x, y, alpha, beta);
+    else                   A.gemv_t(x, y, alpha, beta);
+}
+
+static inline void cgemv(Trans trans, cfloat alpha, ComplexAnalogMatrix& A,
+                         const cfloat* x, cfloat beta, cfloat* y) {
+    xgemv(trans, alpha, A, x, beta, y);
+}
+
+static inline void zgemv(Trans trans, zdouble alpha, ComplexAnalogMatrix& A,
+                         const zdouble* x, zdouble beta, zdouble* y) {
+    xgemv(trans, alpha, A, x, beta, y);
+}
+
+// C = alpha*A*B + beta*C, complex, column-major as in gemm
+static inline void cgemm(int k, cfloat alpha, ComplexAnalogMatrix& A, const cfloat* B, int ldb,
+                         cfloat beta, cfloat* C, int ldc) {
+    A.gemm(B, k, ldb, C, ldc, alpha, beta);
+}
+
+static inline void zgemm(int k, zdouble alpha, ComplexAnalogMatrix& A, const zdouble* B, int ldb,
+                         zdouble beta, zdouble* C, int ldc) {
+    A.gemm(B, k, ldb, C, ldc, alpha, beta);
+}
+
+} // namespace analog
+
+#endif // ANALOG_BLAS_H
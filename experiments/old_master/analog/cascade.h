@@ -0,0 +1,290 @@
+// analog/cascade.h: AnalogCascade, a chain of small operators left on the arrays.
+//
+// y = f_d(W_d ... f_1(W_1 f_0(W_0 x))) for layers W_l (m_l x n_l, with
+// n_{l+1} = m_l) and optional elementwise activations f_l: C*(B*(A*x)) is
+// the linear case, small MLP stacks add activations.
+//
+// Placement walks the layers in order and fills one core's arrays before
+// moving to the next, so consecutive layers share a core. A single-tile
+// layer without activation hands its output to the next layer's arrays on
+// the same core with mvm.mv, provided that layer is one column block wide.
+// Everything else goes through memory: stored, summed over column blocks,
+// activated and loaded again. Core boundaries always go through memory.
+//
+// A batch is pipelined over the cores holding the chain: at step s core c
+// runs vector s - c, with one barrier per step.
+
+#ifndef ANALOG_CASCADE_H
+#define ANALOG_CASCADE_H
+
+#include "analog/matrix.h"
+
+namespace analog {
+
+enum class Activation { None, ReLU, Tanh };
+
+struct Layer {
+    const real* W;            // m x n, row-major
+    int         m, n, ldw;
+    Activation  act = Activation::None;
+};
+
+struct CascadeOptions {
+    bool cascade = true;         // mvm.mv between co-located layers (false: store/load everywhere)
+    bool bcast   = true;         // one mvm.l.bcast per column block of a layer
+                                 // (mvm.l per array in layers holding array ids >= 64)
+    int  arrays_per_core = 0;    // cap on arrays taken from each core's pool (0 = all free)
+};
+
+struct CascadeStats {
+    uint64_t loads  = 0;   // mvm.l / mvm.l.bcast
+    uint64_t mvms   = 0;
+    uint64_t stores = 0;
+    uint64_t moves  = 0;   // mvm.mv
+
+    CascadeStats& operator+=(const CascadeStats& o) {
+        loads += o.loads; mvms += o.mvms; stores += o.stores; moves += o.moves;
+        return *this;
+    }
+};
+
+class AnalogCascade {
+public:
+    struct Stage {
+        int        m, n;
+        int        row_tiles, col_tiles;
+        int        core;
+        Activation act;
+        bool       chained;     // output moves straight into the next stage's arrays
+        bool       bcast;       // mvm.l.bcast loads (every id fits the 64-bit mask)
+        std::vector<int> ids;   // array of tile tr*col_tiles + tc
+    };
+
+    AnalogCascade(const std::vector<Layer>& layers, CascadeOptions opt = CascadeOptions())
+        : opt_(opt), pool_(Pool::get())
+    {
+        const int per_core = opt_.arrays_per_core > 0
+            ? std::min(opt_.arrays_per_core, pool_.slots_per_core()) : pool_.slots_per_core();
+
+        // Consecutive layers fill a core before spilling to the next one
+        int core = 0, used = 0, pad = 0;
+        for (size_t l = 0; l < layers.size(); ++l) {
+            const Layer& L = layers[l];
+            if (l > 0 && L.n != layers[l - 1].m) {
+                std::fprintf(stderr, "AnalogCascade: layer %zu is %dx%d after a %d-row layer\n",
+                             l, L.m, L.n, layers[l - 1].m);
+                std::exit(1);
+            }
+            Stage st{ L.m, L.n, (L.m + TILE_ROWS - 1) / TILE_ROWS, (L.n + TILE_COLS - 1) / TILE_COLS,
+                      0, L.act, false, opt_.bcast, {} };
+            const int tiles = st.row_tiles * st.col_tiles;
+            if (used + tiles > per_core) { ++core; used = 0; }
+            if (tiles > per_core || core >= pool_.cores) {
+                std::fprintf(stderr, "AnalogCascade: layer %zu (%d tiles) does not fit "
+                                     "(%d cores x %d arrays)\n", l, tiles, pool_.cores, per_core);
+                std::exit(1);
+            }
+            st.core = core;
+            used += tiles;
+            for (int t = 0; t < tiles; ++t) {
+                const int id = pool_.allocate(core);
+                if (id < 0) {
+                    std::fprintf(stderr, "AnalogCascade: core %d has no free arrays\n", core);
+                    std::exit(1);
+                }
+                st.ids.push_back(id);
+                if (id >= 64) st.bcast = false;
+            }
+            pad = std::max(pad, std::max(st.row_tiles * TILE_ROWS, st.col_tiles * TILE_COLS));
+            stages_.push_back(st);
+        }
+        cores_ = stages_.empty() ? 0 : stages_.back().core + 1;
+        pad_ = pad;
+
+        for (size_t l = 0; l + 1 < stages_.size(); ++l) {
+            Stage& st = stages_[l];
+            const Stage& nx = stages_[l + 1];
+            st.chained = opt_.cascade && st.act == Activation::None
+                      && st.row_tiles == 1 && st.col_tiles == 1
+                      && nx.col_tiles == 1 && nx.core == st.core;
+        }
+
+        first_.assign(cores_, 0);
+        last_.assign(cores_, -1);
+        for (int l = static_cast<int>(stages_.size()) - 1; l >= 0; --l) first_[stages_[l].core] = l;
+        for (int l = 0; l < static_cast<int>(stages_.size()); ++l) last_[stages_[l].core] = l;
+
+        scratch_.assign(static_cast<size_t>(cores_) * per_scratch(), real(0));
+        links_.assign(static_cast<size_t>(cores_) * 2 * pad_, real(0));
+        stats_.assign(cores_, CascadeStats());
+
+        #pragma omp parallel num_threads(cores_)
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            real* buf = scratch(c);
+            for (int l = first_[c]; l <= last_[c]; ++l) {
+                const Stage& st = stages_[l];
+                for (int t = 0; t < static_cast<int>(st.ids.size()); ++t) {
+                    pack_tile(layers[l], t / st.col_tiles, t % st.col_tiles, buf);
+                    mvm_set(buf, st.ids[t]);
+                }
+            }
+        }
+    }
+
+    ~AnalogCascade() {
+        #pragma omp parallel num_threads(cores_)
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            for (int l = first_[c]; l <= last_[c]; ++l)
+                for (int id : stages_[l].ids) mvm_free(id);
+        }
+        for (const Stage& st : stages_)
+            for (int id : st.ids) pool_.release(st.core, id);
+    }
+
+    AnalogCascade(const AnalogCascade&) = delete;
+    AnalogCascade& operator=(const AnalogCascade&) = delete;
+
+    int cores() const { return cores_; }
+    int depth() const { return static_cast<int>(stages_.size()); }
+    const Stage& stage(int l) const { return stages_[l]; }
+
+    CascadeStats stats() const {
+        CascadeStats s;
+        for (const CascadeStats& cs : stats_) s += cs;
+        return s;
+    }
+
+    void print_stats(std::FILE* f = stdout) const {
+        const CascadeStats s = stats();
+        int chained = 0;
+        for (const Stage& st : stages_) chained += st.chained;
+        std::fprintf(f, "AnalogCascade: %d layers on %d cores, %d chained, loads %llu mvms %llu "
+                        "stores %llu moves %llu\n", depth(), cores_, chained,
+                     static_cast<unsigned long long>(s.loads), static_cast<unsigned long long>(s.mvms),
+                     static_cast<unsigned long long>(s.stores), static_cast<unsigned long long>(s.moves));
+    }
+
+    // y = chain(x)
+    void apply(const real* x, real* y) { apply(x, 1, 0, y, 0); }
+
+    // Y[:, j] = chain(X[:, j]) for k vectors, X + j*ldx and Y + j*ldy
+    void apply(const real* X, int k, int ldx, real* Y, int ldy) {
+        if (cores_ == 0) return;
+        #pragma omp parallel num_threads(cores_)
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            for (int s = 0; s < k + cores_ - 1; ++s) {
+                const int v = s - c;
+                if (v >= 0 && v < k) {
+                    const real* in = c == 0 ? X + static_cast<size_t>(v) * ldx : link(c - 1, v);
+                    real* out = c == cores_ - 1 ? Y + static_cast<size_t>(v) * ldy : link(c, v);
+                    run_core(c, in, out);
+                }
+                #pragma omp barrier
+            }
+        }
+    }
+
+private:
+    // Stages of core c on one vector: in is stages_[first_[c]].n long, out
+    // gets stages_[last_[c]].m entries
+    void run_core(int c, const real* in, real* out) {
+        CascadeStats& cs = stats_[c];
+        real* bufs[2] = { scratch(c), scratch(c) + pad_ };
+        real* xs  = scratch(c) + 2 * pad_;
+        real* tmp = xs + TILE_COLS;
+        const real* cur = in;
+        for (int l = first_[c]; l <= last_[c]; ++l) {
+            const Stage& st = stages_[l];
+            if (l == first_[c] || !stages_[l - 1].chained) {
+                for (int tc = 0; tc < st.col_tiles; ++tc) {
+                    const real* xin = x_slice(cur, tc, st.n, xs);
+                    if (st.bcast && st.row_tiles > 1) {
+                        uint64_t mask = 0;
+                        for (int tr = 0; tr < st.row_tiles; ++tr) mask |= 1ULL << st.ids[tr * st.col_tiles + tc];
+                        mvm_load_bcast(xin, mask);
+                        ++cs.loads;
+                    } else {
+                        for (int tr = 0; tr < st.row_tiles; ++tr) mvm_load(xin, st.ids[tr * st.col_tiles + tc]);
+                        cs.loads += st.row_tiles;
+                    }
+                }
+            }
+            for (int id : st.ids) mvm_exec(id);
+            cs.mvms += st.ids.size();
+
+            if (st.chained) {
+                for (int id : stages_[l + 1].ids) mvm_move(st.ids[0], id);
+                cs.moves += stages_[l + 1].ids.size();
+                continue;
+            }
+
+            real* dst = l == last_[c] ? out : (cur == bufs[0] ? bufs[1] : bufs[0]);
+            std::memset(dst, 0, st.m * sizeof(real));
+            for (int t = 0; t < static_cast<int>(st.ids.size()); ++t) {
+                mvm_store(tmp, st.ids[t]);
+                const int r0 = (t / st.col_tiles) * TILE_ROWS, nr = std::min(TILE_ROWS, st.m - r0);
+                for (int r = 0; r < nr; ++r) dst[r0 + r] += tmp[r];
+            }
+            cs.stores += st.ids.size();
+            activate(st.act, dst, st.m);
+            cur = dst;
+        }
+    }
+
+    static void activate(Activation act, real* v, int n) {
+        switch (act) {
+        case Activation::None: break;
+        case Activation::ReLU: for (int i = 0; i < n; ++i) v[i] = std::max(v[i], real(0)); break;
+        case Activation::Tanh: for (int i = 0; i < n; ++i) v[i] = std::tanh(v[i]); break;
+        }
+    }
+
+    static void pack_tile(const Layer& L, int tr, int tc, real* buf) {
+        const int r0 = tr * TILE_ROWS, c0 = tc * TILE_COLS;
+        const int nr = std::min(TILE_ROWS, L.m - r0), nc = std::min(TILE_COLS, L.n - c0);
+        std::memset(buf, 0, sizeof(real) * TILE_ROWS * TILE_COLS);
+        for (int r = 0; r < nr; ++r)
+            std::memcpy(buf + r * TILE_COLS, L.W + static_cast<size_t>(r0 + r) * L.ldw + c0, nc * sizeof(real));
+    }
+
+    // Column block tc of a len-long vector, zero-padded into buf past the end
+    static const real* x_slice(const real* x, int tc, int len, real* buf) {
+        const int off = tc * TILE_COLS;
+        if (off + TILE_COLS <= len) return x + off;
+        const int valid = std::max(0, len - off);
+        std::memcpy(buf, x + off, valid * sizeof(real));
+        std::memset(buf + valid, 0, (TILE_COLS - valid) * sizeof(real));
+        return buf;
+    }
+
+    // Two ping-pong vectors, a padded x slice and one tile output (or one
+    // packed tile while programming)
+    size_t per_scratch() const {
+        return std::max(static_cast<size_t>(2) * pad_ + TILE_COLS + TILE_ROWS,
+                        static_cast<size_t>(TILE_ROWS) * TILE_COLS);
+    }
+    real* scratch(int c) { return scratch_.data() + static_cast<size_t>(c) * per_scratch(); }
+
+    // Hand-off from core c to c+1 for vector v (two slots: c+1 reads v-1 while c writes v)
+    real* link(int c, int v) { return links_.data() + (static_cast<size_t>(c) * 2 + (v & 1)) * pad_; }
+
+    CascadeOptions            opt_;
+    Pool&                     pool_;
+    int                       cores_ = 0;
+    int                       pad_ = 0;       // longest padded vector of any stage
+    std::vector<Stage>        stages_;
+    std::vector<int>          first_, last_;  // stage range per core
+    std::vector<real>         scratch_;       // per core
+    std::vector<real>         links_;         // per core boundary, two slots
+    std::vector<CascadeStats> stats_;         // per core
+};
+
+} // namespace analog
+
+#endif // ANALOG_CASCADE_H
@@ -0,0 +1,281 @@
+// analog/complex.h: ComplexAnalogMatrix, a complex matrix on real arrays.
+//
+// The arrays only hold real conductances, so A = Ar + i*Ai is mapped in one
+// of two ways:
+//
+//   Expand  one real AnalogMatrix [Ar -Ai; Ai Ar] of size 2m x 2n, driven
+//           with [xr; xi] and read back as [yr; yi]. One MVM pass per
+//           product, but Ar and Ai are each programmed twice.
+//   Split   two AnalogMatrix, Ar and Ai, each driven with xr and xi as one
+//           2-vector mvm.mm; yr = Ar*xr - Ai*xi, yi = Ai*xr + Ar*xi. Half the
+//           arrays, twice the MVMs (on full tiles).
+//
+// Auto picks the cheaper one from tile counts and the arrays each core can
+// give (see choose()). Inputs are deinterleaved into real staging buffers and
+// outputs recombined, with alpha/beta, in omp simd loops. Element type is
+// std::complex<float> (cgemv/cgemm) or std::complex<double> (zgemv/zgemm);
+// doubles are narrowed to analog_elem_t for the arrays.
+// Unlike AnalogMatrix, calls must come from serial code.
+
+#ifndef ANALOG_COMPLEX_H
+#define ANALOG_COMPLEX_H
+
+#include "analog/matrix.h"
+
+#include <complex>
+#include <memory>
+
+namespace analog {
+
+enum class ComplexScheme { Auto, Expand, Split };
+
+class ComplexAnalogMatrix {
+public:
+    template <typename F>
+    ComplexAnalogMatrix(const std::complex<F>* A, int m, int n, int lda,
+                        Options opt = Options(), ComplexScheme scheme = ComplexScheme::Auto)
+        : m_(m), n_(n)
+    {
+        scheme_ = scheme == ComplexScheme::Auto ? choose(m, n, opt) : scheme;
+        const F* a = reinterpret_cast<const F*>(A);   // interleaved re, im
+
+        std::vector<real> buf;
+        if (scheme_ == ComplexScheme::Expand) {
+            const int ld = 2 * n;
+            buf.resize(static_cast<size_t>(2 * m) * ld);
+            for (int r = 0; r < m; ++r) {
+                const F* src = a + 2 * static_cast<size_t>(r) * lda;
+                real* top = buf.data() + static_cast<size_t>(r) * ld;
+                real* bot = top + static_cast<size_t>(m) * ld;
+                for (int c = 0; c < n; ++c) {
+                    const real re = static_cast<real>(src[2 * c]), im = static_cast<real>(src[2 * c + 1]);
+                    top[c] = re;  top[n + c] = -im;
+                    bot[c] = im;  bot[n + c] = re;
+                }
+            }
+            re_.reset(new AnalogMatrix(buf.data(), 2 * m, 2 * n, ld, opt));
+        } else {
+            buf.resize(static_cast<size_t>(2) * m * n);
+            real* ar = buf.data();
+            real* ai = ar + static_cast<size_t>(m) * n;
+            for (int r = 0; r < m; ++r) {
+                const F* src = a + 2 * static_cast<size_t>(r) * lda;
+                for (int c = 0; c < n; ++c) {
+                    ar[static_cast<size_t>(r) * n + c] = static_cast<real>(src[2 * c]);
+                    ai[static_cast<size_t>(r) * n + c] = static_cast<real>(src[2 * c + 1]);
+                }
+            }
+            // Ar and Ai each take at most half of every core's arrays
+            const int slots = std::max(1, Pool::get().slots_per_core() / 2);
+            Options half = opt;
+            half.arrays_per_core = opt.arrays_per_core > 0 ? std::min(opt.arrays_per_core, slots) : slots;
+            re_.reset(new AnalogMatrix(ar, m, n, n, half));
+            im_.reset(new AnalogMatrix(ai, m, n, n, half));
+        }
+    }
+
+    ComplexAnalogMatrix(const ComplexAnalogMatrix&) = delete;
+    ComplexAnalogMatrix& operator=(const ComplexAnalogMatrix&) = delete;
+
+    int rows() const { return m_; }
+    int cols() const { return n_; }
+    ComplexScheme scheme() const { return scheme_; }
+    int tiles() const { return re_->tiles() + (im_ ? im_->tiles() : 0); }
+
+    ResidencyStats stats() const {
+        ResidencyStats s = re_->stats();
+        if (im_) s += im_->stats();
+        return s;
+    }
+
+    void print_stats(std::FILE* f = stdout) const {
+        std::fprintf(f, "ComplexAnalogMatrix %dx%d (%s):\n  ", m_, n_,
+                     scheme_ == ComplexScheme::Expand ? "expand" : "split");
+        re_->print_stats(f);
+        if (im_) { std::fprintf(f, "  "); im_->print_stats(f); }
+    }
+
+    // Scheme with the lower modelled cost per product. An MVM costs one load
+    // and one store (TILE_COLS + TILE_ROWS elements); a tile that does not fit
+    // the arrays a core can give is reprogrammed every product
+    // (TILE_ROWS * TILE_COLS cells). Split caps Ar and Ai at half of a core's
+    // arrays each, as the constructor does.
+    // Arrays held by other matrices are ignored.
+    static ComplexScheme choose(int m, int n, const Options& opt = Options()) {
+        const Pool& pool = Pool::get();
+        const int slots = pool.slots_per_core();
+        const int expand_per_core = opt.arrays_per_core > 0 ? std::min(opt.arrays_per_core, slots) : slots;
+        const int split_per_core  = std::min(expand_per_core, slots / 2);
+        if (split_per_core == 0) return ComplexScheme::Expand;   // Ai would find no free array
+
+        const auto blocks = [](int len, int b) { return static_cast<long>((len + b - 1) / b); };
+        const auto cost = [&](long tiles, long vectors, int per_core) {
+            const long per = (tiles + pool.cores - 1) / pool.cores;   // round-robin placement
+            const long swapped = std::max(0L, per - per_core) * pool.cores;
+            return static_cast<double>(tiles) * vectors * (TILE_ROWS + TILE_COLS)
+                 + static_cast<double>(swapped) * TILE_ROWS * TILE_COLS;
+        };
+        const long t_split = blocks(m, TILE_ROWS) * blocks(n, TILE_COLS);
+        const double expand = cost(blocks(2 * m, TILE_ROWS) * blocks(2 * n, TILE_COLS), 1, expand_per_core);
+        const double split  = 2 * cost(t_split, 2, split_per_core);
+        return expand <= split ? ComplexScheme::Expand : ComplexScheme::Split;
+    }
+
+    // y = alpha*A*x + beta*y
+    template <typename F>
+    void gemv(const std::complex<F>* x, std::complex<F>* y,
+              std::complex<F> alpha = 1, std::complex<F> beta = 0) {
+        if (scheme_ == ComplexScheme::Split) {
+            gemm(x, 1, n_, y, m_, alpha, beta);
+            return;
+        }
+        real* xs = in(2 * n_);
+        real* ys = out(2 * m_);
+        deinterleave(x, n_, xs, xs + n_);
+        re_->gemv(xs, ys);
+        combine(ys, ys + m_, m_, y, alpha, beta);
+    }
+
+    // y = alpha*A^T*x + beta*y (mvm.t on the same tiles). The transposed
+    // expansion is that of A^H, so it is driven with conj(x) and conjugated back.
+    template <typename F>
+    void gemv_t(const std::complex<F>* x, std::complex<F>* y,
+                std::complex<F> alpha = 1, std::complex<F> beta = 0) {
+        real* xs = in(2 * m_);
+        real* xr = xs, *xi = xs + m_;
+        deinterleave(x, m_, xr, xi);
+        if (scheme_ == ComplexScheme::Expand) {
+            real* ys = out(2 * n_);
+            #pragma omp simd
+            for (int i = 0; i < m_; ++i) xi[i] = -xi[i];
+            re_->gemv_t(xs, ys);
+            real* yi = ys + n_;
+            #pragma omp simd
+            for (int j = 0; j < n_; ++j) yi[j] = -yi[j];
+            combine(ys, yi, n_, y, alpha, beta);
+            return;
+        }
+        // yr = Ar^T xr - Ai^T xi, yi = Ai^T xr + Ar^T xi
+        real* ys = out(4 * n_);
+        real* ar_xr = ys, *ar_xi = ys + n_, *ai_xr = ys + 2 * n_, *ai_xi = ys + 3 * n_;
+        re_->gemv_t(xr, ar_xr);
+        re_->gemv_t(xi, ar_xi);
+        im_->gemv_t(xr, ai_xr);
+        im_->gemv_t(xi, ai_xi);
+        #pragma omp simd
+        for (int j = 0; j < n_; ++j) {
+            ar_xr[j] -= ai_xi[j];
+            ai_xr[j] += ar_xi[j];
+        }
+        combine(ar_xr, ai_xr, n_, y, alpha, beta);
+    }
+
+    // Y[:, j] = alpha*A*X[:, j] + beta*Y[:, j] for k column-major vectors
+    template <typename F>
+    void gemm(const std::complex<F>* X, int k, int ldx, std::complex<F>* Y, int ldy,
+              std::complex<F> alpha = 1, std::complex<F> beta = 0) {
+        const size_t mk = static_cast<size_t>(m_) * k, nk = static_cast<size_t>(n_) * k;
+        if (scheme_ == ComplexScheme::Expand) {
+            // Vector j is [xr_j; xi_j], output j is [yr_j; yi_j]
+            real* xs = in(2 * nk);
+            real* ys = out(2 * mk);
+            for (int j = 0; j < k; ++j) {
+                real* xj = xs + static_cast<size_t>(2) * n_ * j;
+                deinterleave(X + static_cast<size_t>(j) * ldx, n_, xj, xj + n_);
+            }
+            re_->gemm(xs, k, 2 * n_, ys, 2 * m_);
+            for (int j = 0; j < k; ++j) {
+                const real* yj = ys + static_cast<size_t>(2) * m_ * j;
+                combine(yj, yj + m_, m_, Y + static_cast<size_t>(j) * ldy, alpha, beta);
+            }
+            return;
+        }
+        // Columns xr_0..xr_{k-1}, xi_0..xi_{k-1} run as one 2k-vector batch
+        real* xs = in(2 * nk);
+        real* ys = out(4 * mk + 2 * static_cast<size_t>(m_));
+        for (int j = 0; j < k; ++j) {
+            deinterleave(X + static_cast<size_t>(j) * ldx, n_,
+                         xs + static_cast<size_t>(n_) * j, xs + nk + static_cast<size_t>(n_) * j);
+        }
+        real* pr = ys;            // Ar * [Xr Xi]
+        real* pi = ys + 2 * mk;   // Ai * [Xr Xi]
+        re_->gemm(xs, 2 * k, n_, pr, m_);
+        im_->gemm(xs, 2 * k, n_, pi, m_);
+        real* yr = ys + 4 * mk;
+        real* yi = yr + m_;
+        for (int j = 0; j < k; ++j) {
+            const real* ar_xr = pr + static_cast<size_t>(m_) * j;
+            const real* ar_xi = ar_xr + mk;
+            const real* ai_xr = pi + static_cast<size_t>(m_) * j;
+            const real* ai_xi = ai_xr + mk;
+            #pragma omp simd
+            for (int i = 0; i < m_; ++i) {
+                yr[i] = ar_xr[i] - ai_xi[i];
+                yi[i] = ai_xr[i] + ar_xi[i];
+            }
+            combine(yr, yi, m_, Y + static_cast<size_t>(j) * ldy, alpha, beta);
+        }
+    }
+
+private:
+    // Every product stages through here first; the buffers are shared, so
+    // unlike AnalogMatrix this class cannot run inside a caller's team
+    real* in(size_t len) {
+        if (omp_in_parallel()) {
+            std::fprintf(stderr, "ComplexAnalogMatrix: must be called outside any parallel region\n");
+            std::exit(1);
+        }
+        if (xs_.size() < len) xs_.resize(len);
+        return xs_.data();
+    }
+
+    real* out(size_t len) {
+        if (ys_.size() < len) ys_.resize(len);
+        return ys_.data();
+    }
+
+    template <typename F>
+    static void deinterleave(const std::complex<F>* x, int len, real* re, real* im) {
+        const F* src = reinterpret_cast<const F*>(x);
+        #pragma omp simd
+        for (int i = 0; i < len; ++i) {
+            re[i] = static_cast<real>(src[2 * i]);
+            im[i] = static_cast<real>(src[2 * i + 1]);
+        }
+    }
+
+    // y = alpha*(yr + i*yi) + beta*y over len entries, in real arithmetic
+    template <typename F>
+    static void combine(const real* yr, const real* yi, int len, std::complex<F>* y,
+                        std::complex<F> alpha, std::complex<F> beta) {
+        F* o = reinterpret_cast<F*>(y);
+        const F ar = alpha.real(), ai = alpha.imag();
+        const F br = beta.real(),  bi = beta.imag();
+        if (beta == std::complex<F>(0)) {
+            #pragma omp simd
+            for (int i = 0; i < len; ++i) {
+                const F re = yr[i], im = yi[i];
+                o[2 * i]     = ar * re - ai * im;
+                o[2 * i + 1] = ar * im + ai * re;
+            }
+        } else {
+            #pragma omp simd
+            for (int i = 0; i < len; ++i) {
+                const F re = yr[i], im = yi[i];
+                const F ore = o[2 * i], oim = o[2 * i + 1];
+                o[2 * i]     = ar * re - ai * im + br * ore - bi * oim;
+                o[2 * i + 1] = ar * im + ai * re + br * oim + bi * ore;
+            }
+        }
+    }
+
+    int m_, n_;
+    ComplexScheme scheme_ = ComplexScheme::Expand;
+    std::unique_ptr<AnalogMatrix> re_;   // expanded matrix, or Ar
+    std::unique_ptr<AnalogMatrix> im_;   // Ai (split only)
+    std::vector<real> xs_, ys_;          // staging
+};
+
+} // namespace analog
+
+#endif // ANALOG_COMPLEX_H
@@ -0,0 +1,382 @@
+// analog/emulator.h: in-process functional model of the mvm ISA.
+//
+// analog/intrinsics.h routes every mvm_* here when ANALOG_EMULATE is set
+// (the default off RISC-V), so the solvers build natively with OpenMP and
+// run in seconds. Semantics follow RoCCAnalog + CrossSimComputeArray:
+//
+//   - each OpenMP thread is one core; CORES_PER_TILE consecutive cores share
+//     one pool of arrays, as in the SST configs
+//   - arrays are ANALOG_TILE_ROWS x ANALOG_TILE_COLS, zero until mvm.set
+//   - status is 0, or 1 for an array id outside the pool (rd=1 on RoCC)
+//
+// Environment (read once):
+//   ANALOG_EMU_ARRAYS      arrays per pool (default NUM_ARRAYS, else 64)
+//   ANALOG_EMU_PROG_NOISE  programming error, sigma relative to max|A_tile|
+//   ANALOG_EMU_READ_NOISE  per-MVM output noise, sigma relative to max|y|
+//   ANALOG_EMU_ADC_BITS    output quantization over [-max|y|, max|y|] (0 = off)
+//   ANALOG_EMU_SEED        noise seed (default 1)
+//   ANALOG_EMU_*_NS        cost model: SET_CELL, LOAD_ELEM, STORE_ELEM, MVM
+//   ANALOG_EMU_REPORT      0 disables the per-op report printed at exit
+
+#ifndef ANALOG_EMULATOR_H
+#define ANALOG_EMULATOR_H
+
+#ifndef __cplusplus
+#error "analog/emulator.h needs C++"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace analog {
+namespace emu {
+
+enum Op { SET, LOAD, EXEC, STORE, MOVE, MOVE_REMOTE, SET_REGION, EXEC_T, MM_CFG, MM, LOAD_BCAST, FREE,
+          SCALE_CFG, NUM_OPS };
+
+static const char* const kOpNames[NUM_OPS] = {
+    "set", "load", "mvm", "store", "mv", "mv.remote", "set.region", "mvm.t", "mm.cfg", "mm", "bcast", "free",
+    "cfg"
+};
+
+struct Config {
+    int      arrays         = 64;
+    int      cores_per_tile = 1;
+    double   prog_noise     = 0.0;
+    double   read_noise     = 0.0;
+    int      adc_bits       = 0;
+    uint64_t seed           = 1;
+    double   set_cell_ns    = 1.0;
+    double   load_elem_ns   = 1.0;
+    double   store_elem_ns  = 1.0;
+    double   mvm_ns         = 100.0;
+    bool     report         = true;
+};
+
+struct Array {
+    std::vector<float> G;          // programmed (noisy) conductances, rows x cols
+    std::vector<float> x;          // input buffer, max(rows, cols)
+    std::vector<float> y;          // output buffer, max(rows, cols)
+    int                ylen = 0;   // entries of y from the last MVM
+    // mvm.cfg registers; kept across mvm.free like the RoCC's
+    float              in_scale = 1.0f, in_offset = 0.0f, out_scale = 1.0f, out_offset = 0.0f;
+};
+
+struct Unit {
+    std::mutex         mtx;        // cores sharing the pool
+    std::vector<Array> arrays;
+    std::mt19937_64    rng;
+};
+
+// mvm.mm.cfg registers; one set per core, like the RoCC's, and only ever
+// touched by that core
+struct MmRegs {
+    void* y = nullptr;
+    int   k = 0, xs = 0, ys = 0;
+};
+
+class Emulator {
+public:
+    static constexpr int R = ANALOG_TILE_ROWS;
+    static constexpr int C = ANALOG_TILE_COLS;
+
+    static Emulator& get() {
+        static Emulator e;
+        return e;
+    }
+
+    // ---- ISA ----
+    uint64_t set(const float* A, int id) {
+        return with(id, SET, static_cast<double>(R) * C * cfg.set_cell_ns, [&](Unit& u, Array& a) {
+            program(u, a, A, 0, R, 0, C, C);
+        });
+    }
+
+    uint64_t set_region(const float* A, int id, int r0, int nr, int c0, int nc) {
+        if (nr <= 0 || nc <= 0 || r0 + nr > R || c0 + nc > C) return 1;
+        return with(id, SET_REGION, static_cast<double>(nr) * nc * cfg.set_cell_ns, [&](Unit& u, Array& a) {
+            program(u, a, A, r0, nr, c0, nc, nc);
+        });
+    }
+
+    uint64_t load(const float* x, int id, bool transposed) {
+        const int n = transposed ? R : C;
+        return with(id, LOAD, n * cfg.load_elem_ns, [&](Unit&, Array& a) {
+            convert_in(a, x, n, a.x.data());
+        });
+    }
+
+    uint64_t load_bcast(const float* x, uint64_t mask) {
+        Unit& u = unit();
+        std::lock_guard<std::mutex> lock(u.mtx);
+        const Array* regs = nullptr;   // lowest selected array converts, as on the RoCC
+        for (int id = 0; id < 64; ++id) {
+            if (!((mask >> id) & 1)) continue;
+            if (id >= cfg.arrays) return 1;
+            if (!regs) regs = &u.arrays[id];
+            convert_in(*regs, x, C, u.arrays[id].x.data());
+        }
+        count(LOAD_BCAST, C * cfg.load_elem_ns);
+        return 0;
+    }
+
+    uint64_t exec(int id, bool transposed) {
+        return with(id, transposed ? EXEC_T : EXEC, cfg.mvm_ns, [&](Unit& u, Array& a) {
+            mvm(u, a, a.x.data(), a.y.data(), transposed);
+        });
+    }
+
+    uint64_t store(float* y, int id, bool transposed) {
+        const int n = transposed ? C : R;
+        return with(id, STORE, n * cfg.store_elem_ns, [&](Unit&, Array& a) {
+            convert_out(a, a.y.data(), n, y);
+        });
+    }
+
+    uint64_t move(int src, int dst) {
+        if (dst < 0 || dst >= cfg.arrays) return 1;
+        return with(src, MOVE, 0.0, [&](Unit& u, Array& a) {
+            std::copy(a.y.begin(), a.y.end(), u.arrays[dst].x.begin());
+        });
+    }
+
+    uint64_t move_remote(int src, int dst_core, int dst) {
+        if (dst < 0 || dst >= cfg.arrays || src < 0 || src >= cfg.arrays) return 1;
+        std::vector<float> y;
+        {
+            Unit& u = unit();
+            std::lock_guard<std::mutex> lock(u.mtx);
+            y = u.arrays[src].y;
+        }
+        Unit& d = unit_of(dst_core);
+        std::lock_guard<std::mutex> lock(d.mtx);
+        std::copy(y.begin(), y.end(), d.arrays[dst].x.begin());
+        count(MOVE_REMOTE, R * (cfg.store_elem_ns + cfg.load_elem_ns));
+        return 0;
+    }
+
+    uint64_t mm_cfg(void* Y, int k, int xs, int ys) {
+        if (k < 1 || k > ANALOG_MM_MAX_K || xs < 0 || xs > ANALOG_MM_MAX_STRIDE ||
+            ys < 0 || ys > ANALOG_MM_MAX_STRIDE) return 1;
+        MmRegs& r = mm_regs(core());
+        r.y = Y; r.k = k; r.xs = xs ? xs : C; r.ys = ys ? ys : R;
+        count(MM_CFG, 0.0);
+        return 0;
+    }
+
+    uint64_t mm(const float* X, int id) {
+        const MmRegs r = mm_regs(core());
+        const double ns = r.k * (C * cfg.load_elem_ns + cfg.mvm_ns + R * cfg.store_elem_ns);
+        return with(id, MM, ns, [&](Unit& u, Array& a) {
+            float* Y = static_cast<float*>(r.y);
+            std::vector<float> xj(C), yj(std::max(R, C));
+            for (int j = 0; j < r.k; ++j) {
+                convert_in(a, X + j * r.xs, C, xj.data());
+                mvm(u, a, xj.data(), yj.data(), false);
+                convert_out(a, yj.data(), R, Y + j * r.ys);
+            }
+        });
+    }
+
+    uint64_t release(int id) {
+        return with(id, FREE, 0.0, [&](Unit&, Array& a) { reset(a); });
+    }
+
+    // s = {in_scale, in_offset, out_scale, out_offset}, or nullptr to reset
+    uint64_t scale(const float* s, int id) {
+        return with(id, SCALE_CFG, 0.0, [&](Unit&, Array& a) {
+            a.in_scale  = s ? s[0] : 1.0f;  a.in_offset  = s ? s[1] : 0.0f;
+            a.out_scale = s ? s[2] : 1.0f;  a.out_offset = s ? s[3] : 0.0f;
+        });
+    }
+
+    // ---- Report ----
+    void report(std::FILE* f) const {
+        double total = 0;
+        std::fprintf(f, "analog emulator: %d arrays/pool, %d cores/tile, %dx%d tiles\n",
+                     cfg.arrays, cfg.cores_per_tile, R, C);
+        for (int op = 0; op < NUM_OPS; ++op) {
+            const uint64_t n = ops[op].load();
+            if (!n) continue;
+            const double ns = static_cast<double>(cost_ps[op].load()) / 1000.0;
+            total += ns;
+            std::fprintf(f, "  %-10s %12llu ops %14.0f ns\n", kOpNames[op],
+                         static_cast<unsigned long long>(n), ns);
+        }
+        std::fprintf(f, "  %-10s %27.0f ns (serial sum)\n", "total", total);
+    }
+
+    uint64_t op_count(int op) const { return ops[op].load(); }
+
+    // Serial sum of the modelled op costs so far
+    double total_ns() const {
+        double ns = 0;
+        for (int op = 0; op < NUM_OPS; ++op) ns += static_cast<double>(cost_ps[op].load()) / 1000.0;
+        return ns;
+    }
+
+    Config cfg;
+
+private:
+    Emulator() {
+#ifdef NUM_ARRAYS
+        cfg.arrays = NUM_ARRAYS;
+#endif
+#ifdef CORES_PER_TILE
+        cfg.cores_per_tile = CORES_PER_TILE;
+#endif
+        env("ANALOG_EMU_ARRAYS", cfg.arrays);
+        env("ANALOG_EMU_PROG_NOISE", cfg.prog_noise);
+        env("ANALOG_EMU_READ_NOISE", cfg.read_noise);
+        env("ANALOG_EMU_ADC_BITS", cfg.adc_bits);
+        env("ANALOG_EMU_SEED", cfg.seed);
+        env("ANALOG_EMU_SET_CELL_NS", cfg.set_cell_ns);
+        env("ANALOG_EMU_LOAD_ELEM_NS", cfg.load_elem_ns);
+        env("ANALOG_EMU_STORE_ELEM_NS", cfg.store_elem_ns);
+        env("ANALOG_EMU_MVM_NS", cfg.mvm_ns);
+        int rep = 1;
+        env("ANALOG_EMU_REPORT", rep);
+        cfg.report = rep != 0;
+        cfg.arrays = std::max(cfg.arrays, 1);
+        cfg.cores_per_tile = std::max(cfg.cores_per_tile, 1);
+        for (int op = 0; op < NUM_OPS; ++op) { ops[op] = 0; cost_ps[op] = 0; }
+        if (cfg.report) std::atexit([] { Emulator::get().report(stderr); });
+    }
+
+    template <typename V> static void env(const char* name, V& v) {
+        const char* s = std::getenv(name);
+        if (s && *s) v = static_cast<V>(std::strtod(s, nullptr));
+    }
+
+    static int core() {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    Unit& unit() { return unit_of(core()); }
+
+    Unit& unit_of(int c) {
+        const size_t p = static_cast<size_t>(c / cfg.cores_per_tile);
+        std::lock_guard<std::mutex> lock(units_mtx);
+        if (p >= units.size()) units.resize(p + 1);
+        if (!units[p]) {
+            units[p].reset(new Unit);
+            units[p]->arrays.resize(cfg.arrays);
+            for (Array& a : units[p]->arrays) reset(a);
+            units[p]->rng.seed(cfg.seed * 0x9e3779b97f4a7c15ULL + p);
+        }
+        return *units[p];
+    }
+
+    MmRegs& mm_regs(int c) {
+        const size_t i = static_cast<size_t>(c);
+        std::lock_guard<std::mutex> lock(units_mtx);
+        if (i >= mm_cfgs.size()) mm_cfgs.resize(i + 1);
+        if (!mm_cfgs[i]) mm_cfgs[i].reset(new MmRegs);
+        return *mm_cfgs[i];
+    }
+
+    static void reset(Array& a) {
+        a.G.assign(static_cast<size_t>(R) * C, 0.0f);
+        a.x.assign(std::max(R, C), 0.0f);
+        a.y.assign(std::max(R, C), 0.0f);
+        a.ylen = R;
+    }
+
+    template <typename F> uint64_t with(int id, Op op, double ns, F&& f) {
+        if (id < 0 || id >= cfg.arrays) return 1;
+        Unit& u = unit();
+        {
+            std::lock_guard<std::mutex> lock(u.mtx);
+            f(u, u.arrays[id]);
+        }
+        count(op, ns);
+        return 0;
+    }
+
+    void count(Op op, double ns) {
+        ops[op].fetch_add(1, std::memory_order_relaxed);
+        cost_ps[op].fetch_add(static_cast<uint64_t>(ns * 1000.0), std::memory_order_relaxed);
+    }
+
+    static void convert_in(const Array& a, const float* x, int n, float* dst) {
+        for (int i = 0; i < n; ++i) dst[i] = a.in_scale * x[i] + a.in_offset;
+    }
+
+    static void convert_out(const Array& a, const float* y, int n, float* dst) {
+        for (int i = 0; i < n; ++i) dst[i] = a.out_scale * y[i] + a.out_offset;
+    }
+
+    // Block (r0, c0, nr x nc) from row-major src with leading dimension ld
+    void program(Unit& u, Array& a, const float* src, int r0, int nr, int c0, int nc, int ld) {
+        float amax = 0.0f;
+        for (int r = 0; r < nr; ++r)
+            for (int c = 0; c < nc; ++c) amax = std::max(amax, std::fabs(src[r * ld + c]));
+        std::normal_distribution<float> n01(0.0f, 1.0f);
+        const float sigma = static_cast<float>(cfg.prog_noise) * amax;
+        for (int r = 0; r < nr; ++r) {
+            for (int c = 0; c < nc; ++c) {
+                float g = src[r * ld + c];
+                if (sigma > 0.0f) g += sigma * n01(u.rng);
+                a.G[(r0 + r) * C + c0 + c] = g;
+            }
+        }
+    }
+
+    void mvm(Unit& u, Array& a, const float* x, float* y, bool transposed) {
+        const int n = transposed ? C : R;
+        if (transposed) {
+            std::fill(y, y + C, 0.0f);
+            for (int r = 0; r < R; ++r)
+                for (int c = 0; c < C; ++c) y[c] += a.G[r * C + c] * x[r];
+        } else {
+            for (int r = 0; r < R; ++r) {
+                float s = 0.0f;
+                for (int c = 0; c < C; ++c) s += a.G[r * C + c] * x[c];
+                y[r] = s;
+            }
+        }
+        a.ylen = n;
+
+        if (cfg.read_noise <= 0.0 && cfg.adc_bits <= 0) return;
+        float ymax = 0.0f;
+        for (int i = 0; i < n; ++i) ymax = std::max(ymax, std::fabs(y[i]));
+        if (ymax == 0.0f) return;
+        std::normal_distribution<float> n01(0.0f, 1.0f);
+        const float sigma = static_cast<float>(cfg.read_noise) * ymax;
+        const float step  = cfg.adc_bits > 0 ? 2.0f * ymax / ((1u << cfg.adc_bits) - 1) : 0.0f;
+        for (int i = 0; i < n; ++i) {
+            float v = y[i];
+            if (sigma > 0.0f) v += sigma * n01(u.rng);
+            if (step > 0.0f) v = std::min(ymax, std::max(-ymax, std::round(v / step) * step));
+            y[i] = v;
+        }
+    }
+
+    std::mutex                           units_mtx;
+    std::vector<std::unique_ptr<Unit>>   units;
+    std::vector<std::unique_ptr<MmRegs>> mm_cfgs;   // per core
+    std::atomic<uint64_t>                ops[NUM_OPS];
+    std::atomic<uint64_t>                cost_ps[NUM_OPS];
+};
+
+} // namespace emu
+} // namespace analog
+
+#endif // ANALOG_EMULATOR_H
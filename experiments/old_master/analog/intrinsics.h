@@ -0,0 +1,286 @@
+// analog/intrinsics.h: RoCC wrappers for the analog MVM coprocessor.
+//
+// Every op is emitted as `.insn r CUSTOM_0, 0x7, <func7>, rd, rs1, rs2`, so
+// the header builds with the stock riscv64 gcc as well as our clang. The
+// func7 map matches RoCCAnalog (newrocc.h).
+//
+// Functions are static inline. Operand ranges are passed as memory operands
+// of the exact tile size, so the compiler keeps unrelated loads/stores and
+// registers live across the instruction instead of flushing all memory.
+// Tile geometry comes from ANALOG_TILE_ROWS / ANALOG_TILE_COLS (launch
+// scripts pass ARRAY_OUTPUT_SIZE / ARRAY_INPUT_SIZE). Ops whose extent is
+// only known at run time (mvm.mm, mvm.set.rows/region) keep a "memory"
+// clobber.
+//
+// Defining ANALOG_INTRINSICS_EXTERN before the include emits out-of-line
+// extern "C" definitions instead (kernel.cpp), for objects that still link
+// against kernel.o.
+//
+// Off RISC-V (or with ANALOG_EMULATE) the same functions call the in-process
+// emulator of analog/emulator.h instead, for native host builds.
+
+#ifndef ANALOG_INTRINSICS_H
+#define ANALOG_INTRINSICS_H
+
+#include <stdint.h>
+
+#ifndef ANALOG_TILE_ROWS
+#define ANALOG_TILE_ROWS 128
+#endif
+#ifndef ANALOG_TILE_COLS
+#define ANALOG_TILE_COLS 128
+#endif
+#ifndef ANALOG_ELEM_TYPE
+#define ANALOG_ELEM_TYPE float
+#endif
+
+// mvm.mm.cfg field limits (k: 16 bits, strides: 24 bits)
+#define ANALOG_MM_MAX_K      0xffff
+#define ANALOG_MM_MAX_STRIDE 0xffffff
+
+#if !defined(__riscv) && !defined(ANALOG_EMULATE)
+#define ANALOG_EMULATE
+#endif
+
+#ifdef ANALOG_EMULATE
+#include "analog/emulator.h"
+#endif
+
+#ifdef ANALOG_INTRINSICS_EXTERN
+#define ANALOG_FN
+#else
+#define ANALOG_FN static inline __attribute__((always_inline))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef ANALOG_ELEM_TYPE analog_elem_t;
+
+// Memory footprints of the operands
+typedef struct { analog_elem_t v[ANALOG_TILE_ROWS * ANALOG_TILE_COLS]; } analog_tile_t;
+typedef struct { analog_elem_t v[ANALOG_TILE_COLS]; } analog_xvec_t;  // mvm.l / mvm.s.t
+typedef struct { analog_elem_t v[ANALOG_TILE_ROWS]; } analog_yvec_t;  // mvm.s / mvm.l.t
+
+// mvm.cfg register block, always binary32
+typedef struct { float in_scale, in_offset, out_scale, out_offset; } analog_scale_t;
+
+#ifdef ANALOG_EMULATE
+
+#define ANALOG_EMU analog::emu::Emulator::get()
+
+ANALOG_FN uint64_t mvm_set(const void* A, int tile_id) { return ANALOG_EMU.set((const float*)A, tile_id); }
+ANALOG_FN uint64_t mvm_load(const void* x, int tile_id) { return ANALOG_EMU.load((const float*)x, tile_id, false); }
+ANALOG_FN uint64_t mvm_exec(int tile_id) { return ANALOG_EMU.exec(tile_id, false); }
+ANALOG_FN uint64_t mvm_store(void* y, int tile_id) { return ANALOG_EMU.store((float*)y, tile_id, false); }
+ANALOG_FN uint64_t mvm_move(int src_tile, int dst_tile) { return ANALOG_EMU.move(src_tile, dst_tile); }
+ANALOG_FN uint64_t mvm_move_remote(int tile_id, int dst_core, int dst_tile) {
+    return ANALOG_EMU.move_remote(tile_id, dst_core, dst_tile);
+}
+ANALOG_FN uint64_t mvm_set_rows(const void* A, int tile_id, int row0, int nrows) {
+    return ANALOG_EMU.set_region((const float*)A, tile_id, row0, nrows, 0, ANALOG_TILE_COLS);
+}
+ANALOG_FN uint64_t mvm_set_region(const void* A, int tile_id, int row0, int nrows, int col0, int ncols) {
+    return ANALOG_EMU.set_region((const float*)A, tile_id, row0, nrows, col0, ncols);
+}
+ANALOG_FN uint64_t mvm_exec_t(int tile_id) { return ANALOG_EMU.exec(tile_id, true); }
+ANALOG_FN uint64_t mvm_load_t(const void* x, int tile_id) { return ANALOG_EMU.load((const float*)x, tile_id, true); }
+ANALOG_FN uint64_t mvm_store_t(void* y, int tile_id) { return ANALOG_EMU.store((float*)y, tile_id, true); }
+ANALOG_FN uint64_t mvm_mm_cfg(void* Y, int k, int x_stride, int y_stride) {
+    return ANALOG_EMU.mm_cfg(Y, k, x_stride, y_stride);
+}
+ANALOG_FN uint64_t mvm_mm(const void* X, int tile_id) { return ANALOG_EMU.mm((const float*)X, tile_id); }
+ANALOG_FN uint64_t mvm_load_bcast(const void* x, uint64_t mask) { return ANALOG_EMU.load_bcast((const float*)x, mask); }
+ANALOG_FN uint64_t mvm_free(int tile_id) { return ANALOG_EMU.release(tile_id); }
+ANALOG_FN uint64_t mvm_cfg(const analog_scale_t* s, int tile_id) { return ANALOG_EMU.scale((const float*)s, tile_id); }
+
+#else // RISC-V RoCC
+
+#define ANALOG_RTYPE(func7, rd, rs1, rs2) \
+    ".insn r CUSTOM_0, 0x7, " #func7 ", " rd ", " rs1 ", " rs2
+
+// mvm.set (func7 0x1): program tile_id from a dense row-major tile
+ANALOG_FN uint64_t mvm_set(const void* A, int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0x1, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(A), "r"((uint64_t)tile_id), "m"(*(const analog_tile_t*)A));
+    return status;
+}
+
+// mvm.l (func7 0x2): load the cols-long input vector
+ANALOG_FN uint64_t mvm_load(const void* x, int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0x2, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(x), "r"((uint64_t)tile_id), "m"(*(const analog_xvec_t*)x));
+    return status;
+}
+
+// mvm (func7 0x3): y = A x; no memory traffic
+ANALOG_FN uint64_t mvm_exec(int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0x3, "%0", "x0", "%1")
+                 : "=r"(status)
+                 : "r"((uint64_t)tile_id));
+    return status;
+}
+
+// mvm.s (func7 0x4): store the rows-long output vector
+ANALOG_FN uint64_t mvm_store(void* y, int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0x4, "%0", "%2", "%3")
+                 : "=r"(status), "=m"(*(analog_yvec_t*)y)
+                 : "r"(y), "r"((uint64_t)tile_id));
+    return status;
+}
+
+// mvm.mv (func7 0x5): src_tile's output becomes dst_tile's input
+ANALOG_FN uint64_t mvm_move(int src_tile, int dst_tile) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0x5, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"((uint64_t)src_tile), "r"((uint64_t)dst_tile));
+    return status;
+}
+
+// mvm.mv.remote (func7 0x6): push tile_id's output into dst_tile's input on dst_core
+ANALOG_FN uint64_t mvm_move_remote(int tile_id, int dst_core, int dst_tile) {
+    uint64_t status;
+    uint64_t dst = ((uint64_t)(uint32_t)dst_core << 32) | (uint32_t)dst_tile;
+    asm volatile(ANALOG_RTYPE(0x6, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"((uint64_t)tile_id), "r"(dst));
+    return status;
+}
+
+// mvm.set.rows (func7 0x7): reprogram nrows full rows starting at row0
+ANALOG_FN uint64_t mvm_set_rows(const void* A, int tile_id, int row0, int nrows) {
+    uint64_t status;
+    uint64_t sel = (uint64_t)(tile_id & 0xffff)
+                 | ((uint64_t)(row0 & 0xffff) << 16)
+                 | ((uint64_t)(nrows & 0xffff) << 32);
+    asm volatile(ANALOG_RTYPE(0x7, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(A), "r"(sel)
+                 : "memory");
+    return status;
+}
+
+// mvm.set.region (func7 0x8): reprogram a dense nrows x ncols block at (row0, col0)
+ANALOG_FN uint64_t mvm_set_region(const void* A, int tile_id, int row0, int nrows, int col0, int ncols) {
+    uint64_t status;
+    uint64_t sel = (uint64_t)(tile_id & 0xffff)
+                 | ((uint64_t)(row0  & 0xfff) << 16)
+                 | ((uint64_t)(nrows & 0xfff) << 28)
+                 | ((uint64_t)(col0  & 0xfff) << 40)
+                 | ((uint64_t)(ncols & 0xfff) << 52);
+    asm volatile(ANALOG_RTYPE(0x8, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(A), "r"(sel)
+                 : "memory");
+    return status;
+}
+
+// mvm.t (func7 0x9): y = A^T x on the tile programmed by mvm_set
+ANALOG_FN uint64_t mvm_exec_t(int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0x9, "%0", "x0", "%1")
+                 : "=r"(status)
+                 : "r"((uint64_t)tile_id));
+    return status;
+}
+
+// Transposed operands: x has tile rows entries, y has tile cols entries
+// (rs2 bit 32 on mvm.l / mvm.s; identical to mvm_load/mvm_store on square tiles)
+ANALOG_FN uint64_t mvm_load_t(const void* x, int tile_id) {
+    uint64_t status;
+    uint64_t sel = (uint64_t)(uint32_t)tile_id | (1ULL << 32);
+    asm volatile(ANALOG_RTYPE(0x2, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(x), "r"(sel), "m"(*(const analog_yvec_t*)x));
+    return status;
+}
+
+ANALOG_FN uint64_t mvm_store_t(void* y, int tile_id) {
+    uint64_t status;
+    uint64_t sel = (uint64_t)(uint32_t)tile_id | (1ULL << 32);
+    asm volatile(ANALOG_RTYPE(0x4, "%0", "%2", "%3")
+                 : "=r"(status), "=m"(*(analog_xvec_t*)y)
+                 : "r"(y), "r"(sel));
+    return status;
+}
+
+// mvm.mm.cfg (func7 0xA): output base, batch size and strides (elements, 0 = dense).
+// Only latches the address; Y is written by mvm_mm. Returns 1 without issuing
+// when k or a stride does not fit its field.
+ANALOG_FN uint64_t mvm_mm_cfg(void* Y, int k, int x_stride, int y_stride) {
+    if (k < 1 || k > ANALOG_MM_MAX_K || x_stride < 0 || x_stride > ANALOG_MM_MAX_STRIDE ||
+        y_stride < 0 || y_stride > ANALOG_MM_MAX_STRIDE) return 1;
+    uint64_t status;
+    uint64_t cfg = (uint64_t)(k & 0xffff)
+                 | ((uint64_t)(x_stride & 0xffffff) << 16)
+                 | ((uint64_t)(y_stride & 0xffffff) << 40);
+    asm volatile(ANALOG_RTYPE(0xA, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(Y), "r"(cfg));
+    return status;
+}
+
+// mvm.mm (func7 0xB): Y[:, j] = A X[:, j] for the k vectors set up by mvm_mm_cfg
+ANALOG_FN uint64_t mvm_mm(const void* X, int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0xB, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(X), "r"((uint64_t)tile_id)
+                 : "memory");
+    return status;
+}
+
+// mvm.l.bcast (func7 0xC): load x once into the input of every array in mask (bit a = array a)
+ANALOG_FN uint64_t mvm_load_bcast(const void* x, uint64_t mask) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0xC, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(x), "r"(mask), "m"(*(const analog_xvec_t*)x));
+    return status;
+}
+
+// mvm.free (func7 0xD): release tile_id's backing array; the next mvm.set rebuilds it
+ANALOG_FN uint64_t mvm_free(int tile_id) {
+    uint64_t status;
+    asm volatile(ANALOG_RTYPE(0xD, "%0", "x0", "%1")
+                 : "=r"(status)
+                 : "r"((uint64_t)tile_id));
+    return status;
+}
+
+// mvm.cfg (func7 0xE): load tile_id's conversion registers from *s (NULL
+// resets them). While set, the operands of mvm.l, mvm.l.bcast, mvm.mm and
+// mvm.s are float in memory for any array type: x*in_scale + in_offset on the
+// way in, y*out_scale + out_offset on the way out. mvm.l.bcast converts with
+// the lowest selected array's registers; mvm.mv moves raw array values.
+// mvm.set is not converted: the tile is in the array's element type, so for
+// integer arrays the caller quantizes A and picks in_scale to match.
+ANALOG_FN uint64_t mvm_cfg(const analog_scale_t* s, int tile_id) {
+    uint64_t status;
+    if (!s) {
+        asm volatile(ANALOG_RTYPE(0xE, "%0", "x0", "%1")
+                     : "=r"(status)
+                     : "r"((uint64_t)tile_id));
+        return status;
+    }
+    asm volatile(ANALOG_RTYPE(0xE, "%0", "%1", "%2")
+                 : "=r"(status)
+                 : "r"(s), "r"((uint64_t)tile_id), "m"(*s));
+    return status;
+}
+
+#endif // ANALOG_EMULATE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ANALOG_INTRINSICS_H
@@ -0,0 +1,529 @@
+// analog/matrix.h: AnalogMatrix, a dense matrix resident on the analog arrays.
+//
+// The matrix is cut into ANALOG_TILE_ROWS x ANALOG_TILE_COLS tiles (edge
+// tiles zero-padded). Tile k = tr*col_tiles + tc goes to core k % cores, in
+// the next free array of that core's pool, and is programmed by the owning
+// thread. Each core only runs its own tiles, leaving one output block per
+// tile; the same OpenMP team then reduces them, each thread summing its own
+// rows of y (row_partition(), reused by the solvers' BLAS-1 in analog/team.h).
+// Tiles are always added in column order, so y does not depend on the core
+// count or placement.
+//
+// Pool geometry defaults to the solver build macros NUM_CORES, NUM_ARRAYS and
+// CORES_PER_TILE (cores sharing one pool draw interleaved slots, as in
+// array_slot()). One OpenMP thread per core, pinned on first use.
+//
+// gemv/gemv_t/gemm fork their own team, or, called by every thread of an
+// enclosing num_threads(cores) region, run in it between barriers, so a
+// solver can keep one region for the whole solve (see analog/team.h).
+//
+// A core with more tiles than arrays keeps the extra tiles in host memory
+// and swaps them in through its ArrayManager (analog/array_manager.h);
+// every product runs the resident tiles first.
+//
+// With scale_tiles each tile is programmed as A/max|A_tile| and its outputs
+// multiplied back on the CPU; scale_regs does the same but loads max|A_tile|
+// into the array's output register (mvm.cfg), so stores come back rescaled.
+// The library (and so scale_regs) assumes a floating-point analog_elem_t;
+// integer arrays would need A quantized to their range and a matching
+// in_scale, which it does not do.
+
+#ifndef ANALOG_MATRIX_H
+#define ANALOG_MATRIX_H
+
+#include "analog/intrinsics.h"
+#include "analog/array_manager.h"
+
+#include <omp.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace analog {
+
+typedef analog_elem_t real;
+
+constexpr int TILE_ROWS = ANALOG_TILE_ROWS;
+constexpr int TILE_COLS = ANALOG_TILE_COLS;
+
+// ---------------- Array pool ----------------
+struct Pool {
+#ifdef NUM_CORES
+    int cores = NUM_CORES;
+#else
+    int cores = omp_get_max_threads();
+#endif
+#ifdef NUM_ARRAYS
+    int arrays = NUM_ARRAYS;
+#else
+    int arrays = 8;
+#endif
+#ifdef CORES_PER_TILE
+    int cores_per_tile = CORES_PER_TILE;
+#else
+    int cores_per_tile = 1;
+#endif
+    std::vector<std::vector<int>> free_slots;   // per core, local slot indices
+
+    static Pool& get() {
+        static Pool p;
+        return p;
+    }
+
+    int slots_per_core() const { return arrays / cores_per_tile; }
+
+    // Array id of local slot j on core c
+    int array_id(int c, int j) const { return c % cores_per_tile + cores_per_tile * j; }
+
+    // Next free array on core c, or -1
+    int allocate(int c) {
+        init();
+        std::vector<int>& fs = free_slots[c];
+        if (fs.empty()) return -1;
+        int j = fs.back();
+        fs.pop_back();
+        return array_id(c, j);
+    }
+
+    void release(int c, int id) {
+        init();
+        free_slots[c].push_back(id / cores_per_tile);
+    }
+
+private:
+    void init() {
+        if (!free_slots.empty()) return;
+        free_slots.resize(cores);
+        for (auto& fs : free_slots) {
+            for (int j = slots_per_core() - 1; j >= 0; --j) fs.push_back(j);
+        }
+    }
+};
+
+// Pin the calling OpenMP thread to core `c` once; OpenMP keeps its threads
+// across parallel regions, so later regions skip the syscall
+static inline void pin_self(int c) {
+    static thread_local int pinned = -1;
+    if (pinned == c) return;
+    cpu_set_t m; CPU_ZERO(&m); CPU_SET(c, &m);
+    sched_setaffinity(0, sizeof(m), &m);
+    pinned = c;
+}
+
+struct Options {
+    bool bcast        = true;    // mvm.l.bcast an x slice to every array of a core that uses it
+                                 // (falls back to mvm.l when any array id is 64 or more)
+    bool scale_tiles  = false;   // program A/max|A_tile| and rescale outputs (full conductance range)
+    bool scale_regs   = false;   // as scale_tiles, rescaling in the coprocessor's output register
+                                 // (floating-point analog_elem_t only)
+    bool skip_zero    = false;   // leave all-zero tiles off the arrays
+    int  arrays_per_core = 0;    // cap on arrays taken from each core's pool (0 = all free)
+    Replacement replacement = Replacement::LRU;   // victim choice when tiles outnumber arrays
+};
+
+// Contiguous split of [0, len) over `parts` threads, cut on cache lines;
+// thread c owns [begin(c), end(c)), possibly empty
+struct Partition {
+    std::vector<int> lo;
+
+    Partition() : lo(1, 0) {}
+    Partition(int len, int parts, int align = 64 / sizeof(real)) : lo(parts + 1) {
+        const int units = (len + align - 1) / align;
+        for (int c = 0; c <= parts; ++c)
+            lo[c] = std::min(len, static_cast<int>(static_cast<int64_t>(c) * units / parts) * align);
+    }
+
+    int parts() const { return static_cast<int>(lo.size()) - 1; }
+    int len() const { return lo.back(); }
+    int begin(int c) const { return lo[c]; }
+    int end(int c) const { return lo[c + 1]; }
+    int size(int c) const { return lo[c + 1] - lo[c]; }
+};
+
+class AnalogMatrix {
+public:
+    struct Tile {
+        int    tr, tc;      // tile coordinates
+        int    core;        // owning core
+        int    slot;        // ArrayManager slot, -1 when not resident
+        real   scale;       // output multiplier (1 unless scale_tiles)
+        size_t host;        // offset of the packed copy in host_, or npos
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    AnalogMatrix(const real* A, int m, int n, int lda, Options opt = Options())
+        : m_(m), n_(n), opt_(opt), pool_(Pool::get())
+    {
+        row_tiles_ = (m + TILE_ROWS - 1) / TILE_ROWS;
+        col_tiles_ = (n + TILE_COLS - 1) / TILE_COLS;
+        cores_     = pool_.cores;
+
+        // Placement is decided up front so every thread knows its tiles
+        by_core_.resize(cores_);
+        for (int k = 0; k < row_tiles_ * col_tiles_; ++k) {
+            Tile t{ k / col_tiles_, k % col_tiles_, 0, -1, real(1), npos };
+            const real amax = tile_max_abs(A, lda, t.tr, t.tc);
+            if (opt_.skip_zero && amax == real(0)) continue;
+            if ((opt_.scale_tiles || opt_.scale_regs) && amax > real(0)) t.scale = amax;
+            t.core = static_cast<int>(tiles_.size()) % cores_;
+            by_core_[t.core].push_back(static_cast<int>(tiles_.size()));
+            tiles_.push_back(t);
+        }
+
+        // Arrays per core; tiles beyond that live on the host
+        managers_.resize(cores_);
+        order_.resize(cores_);
+        size_t host_tiles = 0;
+        for (int c = 0; c < cores_; ++c) {
+            const int want = static_cast<int>(by_core_[c].size());
+            const int cap  = opt_.arrays_per_core > 0 ? std::min(want, opt_.arrays_per_core) : want;
+            std::vector<int> ids;
+            for (int id; static_cast<int>(ids.size()) < cap && (id = pool_.allocate(c)) >= 0; )
+                ids.push_back(id);
+            if (want > 0 && ids.empty()) {
+                std::fprintf(stderr, "AnalogMatrix: core %d has no free arrays "
+                                     "(%d cores x %d arrays, %d cores/tile)\n",
+                             c, cores_, pool_.arrays, pool_.cores_per_tile);
+                std::exit(1);
+            }
+            managers_[c].init(ids, opt_.replacement);
+            for (int id : ids) {
+                if (id >= 64) opt_.bcast = false;   // mvm.l.bcast masks cover arrays 0..63
+            }
+            if (want > static_cast<int>(ids.size())) {
+                for (int i : by_core_[c]) tiles_[i].host = (host_tiles++) * TILE_ROWS * TILE_COLS;
+            }
+        }
+        host_.assign(host_tiles * TILE_ROWS * TILE_COLS, real(0));
+
+        // Tiles of each row block / column block, in index order (reductions)
+        row_members_.resize(row_tiles_);
+        col_members_.resize(col_tiles_);
+        for (int i = 0; i < tiles(); ++i) {
+            row_members_[tiles_[i].tr].push_back(i);
+            col_members_[tiles_[i].tc].push_back(i);
+        }
+
+        rows_ = Partition(m_, cores_);
+        cols_ = Partition(n_, cores_);
+
+        span_ = std::max(TILE_ROWS, TILE_COLS);
+        partials_.assign(tiles_.size() * span_, real(0));
+        scratch_.assign(static_cast<size_t>(cores_) * TILE_ROWS * TILE_COLS, real(0));
+
+        #pragma omp parallel num_threads(cores_)
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            ArrayManager& am = managers_[c];
+            // The first capacity() tiles start resident
+            for (size_t j = 0; j < by_core_[c].size(); ++j) {
+                Tile& t = tiles_[by_core_[c][j]];
+                real* buf = t.host != npos ? host_.data() + t.host : scratch(c);
+                pack_tile(A, lda, t, buf);
+                if (static_cast<int>(j) < am.capacity()) {
+                    am.acquire(t.slot, [&](int id) { program(t, buf, id); });
+                }
+            }
+            am.reset_stats();
+        }
+    }
+
+    ~AnalogMatrix() {
+        #pragma omp parallel num_threads(cores_)
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            for (int id : managers_[c].arrays()) {
+                if (opt_.scale_regs) mvm_cfg(nullptr, id);
+                mvm_free(id);
+            }
+        }
+        for (int c = 0; c < cores_; ++c) {
+            for (int id : managers_[c].arrays()) pool_.release(c, id);
+        }
+    }
+
+    AnalogMatrix(const AnalogMatrix&) = delete;
+    AnalogMatrix& operator=(const AnalogMatrix&) = delete;
+
+    int rows() const { return m_; }
+    int cols() const { return n_; }
+    int tiles() const { return static_cast<int>(tiles_.size()); }
+
+    // Rows of y (and x) each thread writes in gemv; columns in gemv_t
+    const Partition& row_partition() const { return rows_; }
+    const Partition& col_partition() const { return cols_; }
+
+    // Hits/misses/reprograms over all cores since construction
+    ResidencyStats stats() const {
+        ResidencyStats s;
+        for (const ArrayManager& am : managers_) s += am.stats();
+        return s;
+    }
+
+    void print_stats(std::FILE* f = stdout) const {
+        const ResidencyStats s = stats();
+        std::fprintf(f, "AnalogMatrix %dx%d: %d tiles, hits %llu misses %llu reprograms %llu\n",
+                     m_, n_, tiles(), static_cast<unsigned long long>(s.hits),
+                     static_cast<unsigned long long>(s.misses),
+                     static_cast<unsigned long long>(s.reprograms));
+    }
+
+    // y = alpha*A*x + beta*y. Inside a team, each thread returns once its
+    // row_partition() share of y is done; other rows need a barrier.
+    void gemv(const real* x, real* y, real alpha = 1, real beta = 0) {
+        run([&](int c) {
+            real* xs  = scratch(c);                 // padded x slice
+            real* tmp = scratch(c) + TILE_COLS;     // one tile's output
+
+            const std::vector<int>& order = schedule(c);
+            if (opt_.bcast) {
+                // Every resident array of this core that shares a column block takes one load
+                for (int tc = 0; tc < col_tiles_; ++tc) {
+                    uint64_t mask = 0;
+                    for (int i : order) {
+                        const Tile& t = tiles_[i];
+                        if (t.slot >= 0 && t.tc == tc) mask |= 1ULL << managers_[c].arrays()[t.slot];
+                    }
+                    if (mask) mvm_load_bcast(x_slice(x, tc, n_, TILE_COLS, xs), mask);
+                }
+            }
+            for (int i : order) {
+                const Tile& t = tiles_[i];
+                const bool loaded = opt_.bcast && t.slot >= 0;
+                const int  id = resident(c, i);
+                if (!loaded) mvm_load(x_slice(x, t.tc, n_, TILE_COLS, xs), id);
+                mvm_exec(id);
+                mvm_store(tmp, id);
+                real* dst = partial(i);
+                const real s = cpu_scale(t);
+                for (int r = 0; r < TILE_ROWS; ++r) dst[r] = s * tmp[r];
+            }
+            #pragma omp barrier
+            reduce(row_members_, TILE_ROWS, rows_, y, alpha, beta);
+        });
+    }
+
+    // y = alpha*A^T*x + beta*y, on the same programmed tiles (mvm.t); inside a
+    // team, as gemv with col_partition()
+    void gemv_t(const real* x, real* y, real alpha = 1, real beta = 0) {
+        run([&](int c) {
+            real* xs  = scratch(c);
+            real* tmp = scratch(c) + TILE_ROWS;
+            for (int i : schedule(c)) {
+                const Tile& t = tiles_[i];
+                const int id = resident(c, i);
+                mvm_load_t(x_slice(x, t.tr, m_, TILE_ROWS, xs), id);
+                mvm_exec_t(id);
+                mvm_store_t(tmp, id);
+                real* dst = partial(i);
+                const real s = cpu_scale(t);
+                for (int j = 0; j < TILE_COLS; ++j) dst[j] = s * tmp[j];
+            }
+            #pragma omp barrier
+            reduce(col_members_, TILE_COLS, cols_, y, alpha, beta);
+        });
+    }
+
+    // Y[:, j] = alpha*A*X[:, j] + beta*Y[:, j] for k vectors. Vector j of X
+    // starts at X + j*ldx, of Y at Y + j*ldy. Tiles run them as one mvm.mm.
+    // Inside a team, Y is complete on return (the reduction ends in a barrier).
+    void gemm(const real* X, int k, int ldx, real* Y, int ldy, real alpha = 1, real beta = 0) {
+        const size_t per_core = static_cast<size_t>(k) * (TILE_COLS + TILE_ROWS);
+        const size_t per_tile = static_cast<size_t>(k) * TILE_ROWS;     // tile i's k output blocks
+
+        run([&](int c) {
+            #pragma omp single
+            {
+                if (mm_scratch_.size() < per_core * cores_) mm_scratch_.resize(per_core * cores_);
+                if (mm_partials_.size() < tiles_.size() * per_tile) mm_partials_.resize(tiles_.size() * per_tile);
+            }
+            real* xs   = mm_scratch_.data() + per_core * c;              // k x TILE_COLS
+            real* ys   = xs + static_cast<size_t>(k) * TILE_COLS;        // k x TILE_ROWS
+
+            for (int i : schedule(c)) {
+                const Tile& t = tiles_[i];
+                const int id = resident(c, i);
+                // Full column blocks are read in place with stride ldx; edges, and
+                // strides too wide for mvm.mm.cfg, are packed
+                const bool pack = (t.tc + 1) * TILE_COLS > n_ || ldx > ANALOG_MM_MAX_STRIDE;
+                for (int j0 = 0; j0 < k; j0 += ANALOG_MM_MAX_K) {
+                    const int kb = std::min(k - j0, ANALOG_MM_MAX_K);
+                    const real* xin = X + static_cast<size_t>(j0) * ldx + t.tc * TILE_COLS;
+                    real* yb = ys + static_cast<size_t>(j0) * TILE_ROWS;
+                    int xstride = ldx;
+                    if (pack) {
+                        for (int j = 0; j < kb; ++j) {
+                            real* dst = xs + static_cast<size_t>(j) * TILE_COLS;
+                            const real* src = x_slice(X + static_cast<size_t>(j0 + j) * ldx, t.tc, n_, TILE_COLS, dst);
+                            if (src != dst) std::memcpy(dst, src, TILE_COLS * sizeof(real));
+                        }
+                        xin = xs;
+                        xstride = 0;
+                    }
+                    if (mvm_mm_cfg(yb, kb, xstride, 0) != 0 || mvm_mm(xin, id) != 0) {
+                        // No batched MVM on this array model: kb single MVMs
+                        for (int j = 0; j < kb; ++j) {
+                            mvm_load(xstride ? xin + static_cast<size_t>(j) * xstride
+                                             : xin + static_cast<size_t>(j) * TILE_COLS, id);
+                            mvm_exec(id);
+                            mvm_store(yb + static_cast<size_t>(j) * TILE_ROWS, id);
+                        }
+                    }
+                }
+                const real s = cpu_scale(t);
+                real* dst = mm_partials_.data() + i * per_tile;
+                for (size_t r = 0; r < per_tile; ++r) dst[r] = s * ys[r];
+            }
+            #pragma omp barrier
+            #pragma omp for collapse(2) schedule(static)
+            for (int j = 0; j < k; ++j) {
+                for (int tr = 0; tr < row_tiles_; ++tr) {
+                    const int lo = tr * TILE_ROWS, hi = std::min(m_, lo + TILE_ROWS);
+                    reduce_block(row_members_[tr], mm_partials_.data() + j * TILE_ROWS, per_tile,
+                                 lo, lo, hi, Y + j * ldy, alpha, beta);
+                }
+            }
+        });
+    }
+
+private:
+    // f(core) on every thread: in the caller's team when already inside one
+    // (after a barrier, so x and the partials are free), else in a new one
+    template <typename F>
+    void run(F f) {
+        if (omp_in_parallel()) {
+            if (omp_get_num_threads() != cores_) {
+                std::fprintf(stderr, "AnalogMatrix: called from a team of %d threads, need %d\n",
+                             omp_get_num_threads(), cores_);
+                std::exit(1);
+            }
+            pin_self(omp_get_thread_num());
+            #pragma omp barrier
+            f(omp_get_thread_num());
+            return;
+        }
+        #pragma omp parallel num_threads(cores_)
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            f(c);
+        }
+    }
+
+    // This core's tiles, resident ones first
+    const std::vector<int>& schedule(int c) {
+        std::vector<int>& order = order_[c];
+        order.clear();
+        for (int i : by_core_[c]) if (tiles_[i].slot >= 0) order.push_back(i);
+        for (int i : by_core_[c]) if (tiles_[i].slot < 0)  order.push_back(i);
+        return order;
+    }
+
+    // Array holding tile i, programming it from the host copy on a miss
+    int resident(int c, int i) {
+        Tile& t = tiles_[i];
+        const real* buf = t.host != npos ? host_.data() + t.host : nullptr;
+        return managers_[c].acquire(t.slot, [&](int id) { program(t, buf, id); });
+    }
+
+    // mvm.set, plus the tile's output scale when the coprocessor applies it
+    void program(const Tile& t, const real* buf, int id) const {
+        mvm_set(buf, id);
+        if (opt_.scale_regs) {
+            const analog_scale_t regs = { 1.0f, 0.0f, static_cast<float>(t.scale), 0.0f };
+            mvm_cfg(&regs, id);
+        }
+    }
+
+    // Multiplier the CPU still applies to tile t's outputs
+    real cpu_scale(const Tile& t) const { return opt_.scale_regs ? real(1) : t.scale; }
+
+    real tile_max_abs(const real* A, int lda, int tr, int tc) const {
+        real amax = 0;
+        const int r1 = std::min(m_, (tr + 1) * TILE_ROWS), c1 = std::min(n_, (tc + 1) * TILE_COLS);
+        for (int r = tr * TILE_ROWS; r < r1; ++r)
+            for (int col = tc * TILE_COLS; col < c1; ++col) amax = std::max(amax, std::fabs(A[r * lda + col]));
+        return amax;
+    }
+
+    void pack_tile(const real* A, int lda, const Tile& t, real* buf) const {
+        const int r0 = t.tr * TILE_ROWS, c0 = t.tc * TILE_COLS;
+        const int nr = std::min(TILE_ROWS, m_ - r0), nc = std::min(TILE_COLS, n_ - c0);
+        const real inv = real(1) / t.scale;
+        std::memset(buf, 0, sizeof(real) * TILE_ROWS * TILE_COLS);
+        for (int r = 0; r < nr; ++r) {
+            const real* src = A + (r0 + r) * lda + c0;
+            real* dst = buf + r * TILE_COLS;
+            if (t.scale == real(1)) std::memcpy(dst, src, nc * sizeof(real));
+            else for (int col = 0; col < nc; ++col) dst[col] = src[col] * inv;
+        }
+    }
+
+    // Block b of a len-long vector, zero-padded into buf when it runs past the end
+    static const real* x_slice(const real* x, int b, int len, int block, real* buf) {
+        const int off = b * block;
+        if (off + block <= len) return x + off;
+        const int valid = std::max(0, len - off);
+        std::memcpy(buf, x + off, valid * sizeof(real));
+        std::memset(buf + valid, 0, (block - valid) * sizeof(real));
+        return buf;
+    }
+
+    real* partial(int i) { return partials_.data() + static_cast<size_t>(i) * span_; }
+    real* scratch(int c) { return scratch_.data() + static_cast<size_t>(c) * TILE_ROWS * TILE_COLS; }
+
+    // out[lo, hi) = alpha * sum of the member tiles' outputs + beta * out, for
+    // rows of the block starting at base; tile t's output is parts + t*stride
+    static void reduce_block(const std::vector<int>& members, const real* parts, size_t stride,
+                             int base, int lo, int hi, real* out, real alpha, real beta) {
+        for (int i = lo; i < hi; ++i) {
+            real s = 0;
+            for (int t : members) s += parts[t * stride + (i - base)];
+            out[i] = alpha * s + (beta == real(0) ? real(0) : beta * out[i]);
+        }
+    }
+
+    // Called by every thread of the team after the partials are complete;
+    // thread c writes only its share of out
+    void reduce(const std::vector<std::vector<int>>& members, int block, const Partition& part,
+                real* out, real alpha, real beta) {
+        const int c = omp_get_thread_num();
+        for (int lo = part.begin(c), hi; lo < part.end(c); lo = hi) {
+            const int b = lo / block;
+            hi = std::min(part.end(c), (b + 1) * block);
+            reduce_block(members[b], partials_.data(), span_, b * block, lo, hi, out, alpha, beta);
+        }
+    }
+
+    int     m_, n_;
+    int     row_tiles_ = 0, col_tiles_ = 0, cores_ = 1;
+    int     span_ = 0;          // partials_ per tile
+    Options opt_;
+    Pool&   pool_;
+
+    std::vector<Tile>             tiles_;
+    std::vector<std::vector<int>> by_core_;     // tile indices per core
+    std::vector<std::vector<int>> row_members_; // tiles of row block tr, by column
+    std::vector<std::vector<int>> col_members_; // ... of column block tc, by row
+    Partition                     rows_, cols_; // reduction (and BLAS-1) ownership
+    std::vector<real>             partials_;    // tiles x span (one output block each)
+    std::vector<real>             scratch_;     // cores x one tile
+    std::vector<real>             mm_partials_;
+    std::vector<real>             mm_scratch_;
+    std::vector<ArrayManager>     managers_;    // per core
+    std::vector<std::vector<int>> order_;       // per-core schedule scratch
+    std::vector<real>             host_;        // packed tiles of oversubscribed cores
+};
+
+} // namespace analog
+
+#endif // ANALOG_MATRIX_H
@@ -0,0 +1,176 @@
+// analog/team.h: Team, the solvers' BLAS-1 spread over the AnalogMatrix team.
+//
+// Vectors of length rows() are split by the matrix's row partition, so
+// thread c always touches the rows of y it reduces in gemv: fill()/copy()
+// first-touch them there and every later update stays on that core. Each
+// op runs the analog/vec.h kernel on the calling thread's rows when every
+// thread of an enclosing num_threads(parts) region calls it, else forks
+// such a team itself.
+//
+// Reductions are cut into fixed kBlock-row blocks (one cache line, which is
+// also the partition's granularity); each block's partial goes to a shared
+// slot and every thread adds the slots in block order. Results therefore do
+// not depend on timing or on the core count, at the cost of len/kBlock adds
+// per thread per reduction.
+//
+// Inside a team, element-wise ops need no barrier (each thread only reads
+// and writes its own rows) and a reduction costs one: partials alternate
+// between two buffers, so a thread can race into the next reduction before
+// the others have read this one. gemv barriers itself before reading x.
+
+#ifndef ANALOG_TEAM_H
+#define ANALOG_TEAM_H
+
+#include "analog/matrix.h"
+#include "analog/vec.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace analog {
+
+class Team {
+public:
+    explicit Team(const Partition& rows)
+        : rows_(rows), blocks_((rows.len() + kBlock - 1) / kBlock),
+          partials_(static_cast<size_t>(2 * kMaxK) * blocks_, real(0)),
+          phase_(static_cast<size_t>(rows.parts()) * kBlock, 0)
+    {
+        for (int c = 0; c < parts(); ++c) {
+            if (rows_.begin(c) % kBlock != 0) {
+                std::fprintf(stderr, "Team: partition cut at row %d, not a multiple of %d\n",
+                             rows_.begin(c), kBlock);
+                std::exit(1);
+            }
+        }
+    }
+
+    int parts() const { return rows_.parts(); }
+    int rows() const { return rows_.len(); }
+    const Partition& partition() const { return rows_; }
+
+    // v = value / dst = src, touching each row from its owner first
+    void fill(real* v, real value) {
+        each([&](int lo, int n) { std::fill(v + lo, v + lo + n, value); });
+    }
+    void copy(real* dst, const real* src) {
+        each([&](int lo, int n) { std::copy(src + lo, src + lo + n, dst + lo); });
+    }
+    // dst = a - b
+    void sub(real* dst, const real* a, const real* b) {
+        each([&](int lo, int n) { vec::waxpy(dst + lo, a + lo, real(-1), b + lo, n); });
+    }
+
+    real dot(const real* a, const real* b) {
+        return sum([&](int lo, int n) { return vec::dot(a + lo, b + lo, n); });
+    }
+    real norm2(const real* a) { return std::sqrt(dot(a, a)); }
+
+    void axpy(real* y, const real* x, real a) {
+        each([&](int lo, int n) { vec::axpy(y + lo, x + lo, a, n); });
+    }
+    void xpby(real* p, const real* r, real beta) {
+        each([&](int lo, int n) { vec::xpby(p + lo, r + lo, beta, n); });
+    }
+
+    // Fused solver updates, as in analog/vec.h
+    real cg_update(real* x, real* r, const real* p, const real* Ap, real alpha) {
+        return sum([&](int lo, int n) { return vec::cg_update(x + lo, r + lo, p + lo, Ap + lo, alpha, n); });
+    }
+    void bicg_p(real* p, const real* r, const real* v, real beta, real omega) {
+        each([&](int lo, int n) { vec::bicg_p(p + lo, r + lo, v + lo, beta, omega, n); });
+    }
+    real bicg_s(real* s, const real* r, const real* v, real alpha) {
+        return sum([&](int lo, int n) { return vec::bicg_s(s + lo, r + lo, v + lo, alpha, n); });
+    }
+    real bicg_xr(real* x, real* r, const real* p, const real* s, const real* t, real alpha, real omega) {
+        return sum([&](int lo, int n) {
+            return vec::bicg_xr(x + lo, r + lo, p + lo, s + lo, t + lo, alpha, omega, n);
+        });
+    }
+    void dot2(const real* t, const real* s, real& tt, real& ts) {
+        real out[2];
+        sum<2>([&](int lo, int n, real* part) { vec::dot2(t + lo, s + lo, n, part[0], part[1]); }, out);
+        tt = out[0];
+        ts = out[1];
+    }
+
+private:
+    static constexpr int kBlock = 64 / sizeof(real);  // rows per reduction block
+    static constexpr int kMaxK  = 2;                  // values per reduction (dot2)
+
+    // Partials of value k in buffer ph, one per block
+    real* partials(int ph, int k) { return partials_.data() + static_cast<size_t>(ph * kMaxK + k) * blocks_; }
+
+    // f(lo, n) on every thread's rows
+    template <typename F>
+    void each(F f) {
+        if (omp_in_parallel()) {
+            const int c = omp_get_thread_num();
+            f(rows_.begin(c), rows_.size(c));
+            return;
+        }
+        #pragma omp parallel num_threads(parts())
+        {
+            const int c = omp_get_thread_num();
+            pin_self(c);
+            f(rows_.begin(c), rows_.size(c));
+        }
+    }
+
+    template <typename F>
+    real sum(F f) {
+        real s;
+        sum<1>([&](int lo, int n, real* part) { part[0] = f(lo, n); }, &s);
+        return s;
+    }
+
+    // out[0..K) = sums over blocks of f(lo, n, part[K]); in a team, every
+    // thread gets the result
+    template <int K, typename F>
+    void sum(F f, real* out) {
+        if (omp_in_parallel()) {
+            team_sum<K>(f, out);
+            return;
+        }
+        #pragma omp parallel num_threads(parts())
+        {
+            pin_self(omp_get_thread_num());
+            real t[K];
+            team_sum<K>(f, t);
+            #pragma omp master
+            std::copy(t, t + K, out);
+        }
+    }
+
+    template <int K, typename F>
+    void team_sum(F f, real* out) {
+        static_assert(K <= kMaxK, "too many values per reduction");
+        const int c = omp_get_thread_num();
+        int& ph = phase_[static_cast<size_t>(c) * kBlock];
+        for (int lo = rows_.begin(c); lo < rows_.end(c); lo += kBlock) {
+            real part[K];
+            f(lo, std::min(kBlock, rows_.end(c) - lo), part);
+            for (int k = 0; k < K; ++k) partials(ph, k)[lo / kBlock] = part[k];
+        }
+        #pragma omp barrier
+        for (int k = 0; k < K; ++k) {
+            const real* p = partials(ph, k);
+            real s = 0;
+            for (int b = 0; b < blocks_; ++b) s += p[b];
+            out[k] = s;
+        }
+        ph ^= 1;
+    }
+
+    Partition         rows_;
+    int               blocks_;
+    std::vector<real> partials_;   // two buffers x kMaxK values x blocks
+    std::vector<int>  phase_;      // buffer each thread uses next, one cache line apart
+};
+
+} // namespace analog
+
+#endif // ANALOG_TEAM_H
@@ -0,0 +1,93 @@
+// analog/vec.h: BLAS-1 kernels for the solver updates around the MVMs.
+//
+// Plain dot/axpy/norm2 plus the fused CG and BiCGSTAB updates, so each
+// iteration streams every vector once. The loops keep the solvers' original
+// evaluation order.
+//
+// Kernels work on one contiguous range; callers split vectors themselves.
+
+#ifndef ANALOG_VEC_H
+#define ANALOG_VEC_H
+
+#include <cmath>
+
+namespace analog {
+namespace vec {
+
+// a . b
+static inline float dot(const float* a, const float* b, int n) {
+    float s = 0.0f;
+    for (int i = 0; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+// ||a||_2
+static inline float norm2(const float* a, int n) {
+    return std::sqrt(dot(a, a, n));
+}
+
+// tt = t . t and ts = t . s in one pass
+static inline void dot2(const float* t, const float* s, int n, float& tt, float& ts) {
+    float a = 0.0f, b = 0.0f;
+    for (int i = 0; i < n; ++i) { a += t[i] * t[i]; b += t[i] * s[i]; }
+    tt = a;
+    ts = b;
+}
+
+// y += a*x
+static inline void axpy(float* y, const float* x, float a, int n) {
+    for (int i = 0; i < n; ++i) y[i] += a * x[i];
+}
+
+// p = r + beta*p
+static inline void xpby(float* p, const float* r, float beta, int n) {
+    for (int i = 0; i < n; ++i) p[i] = r[i] + beta * p[i];
+}
+
+// y = x + a*z
+static inline void waxpy(float* y, const float* x, float a, const float* z, int n) {
+    for (int i = 0; i < n; ++i) y[i] = x[i] + a * z[i];
+}
+
+// CG step: x += alpha*p, r -= alpha*Ap; returns the new r . r
+static inline float cg_update(float* x, float* r, const float* p, const float* Ap, float alpha, int n) {
+    float s = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        x[i] += alpha * p[i];
+        r[i] -= alpha * Ap[i];
+        s += r[i] * r[i];
+    }
+    return s;
+}
+
+// BiCGSTAB direction: p = r + beta*(p - omega*v)
+static inline void bicg_p(float* p, const float* r, const float* v, float beta, float omega, int n) {
+    for (int i = 0; i < n; ++i) p[i] = r[i] + beta * (p[i] - omega * v[i]);
+}
+
+// BiCGSTAB half step: s = r - alpha*v; returns s . s
+static inline float bicg_s(float* s, const float* r, const float* v, float alpha, int n) {
+    float ss = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        s[i] = r[i] - alpha * v[i];
+        ss += s[i] * s[i];
+    }
+    return ss;
+}
+
+// BiCGSTAB full step: x += alpha*p + omega*s, r = s - omega*t; returns r . r
+static inline float bicg_xr(float* x, float* r, const float* p, const float* s, const float* t,
+                            float alpha, float omega, int n) {
+    float rr = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        x[i] += alpha * p[i] + omega * s[i];
+        r[i]  = s[i] - omega * t[i];
+        rr += r[i] * r[i];
+    }
+    return rr;
+}
+
+} // namespace vec
+} // namespace analog
+
+#endif // ANALOG_VEC_H
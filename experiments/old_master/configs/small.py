@@ -39,6 +39,7 @@
 # w/o RoCC
 # 16, 32, 64 cores
 
+import json
 import os
 import sst
 
@@ -123,6 +124,20 @@ num_arrays = int(os.getenv("GOLEM_NUM_ARRAYS", 1))
 array_input_size = os.getenv("ARRAY_INPUT_SIZE")
 array_output_size = os.getenv("ARRAY_OUTPUT_SIZE")
 
+# Shared tiles: >1 puts that many cores' RoCC front-ends on one array pool of
+# GOLEM_NUM_ARRAYS arrays (1 keeps a private array bank per core)
+cores_per_tile = int(os.getenv("GOLEM_CORES_PER_TILE", 1))
+tile_type = os.getenv("GOLEM_TILE_TYPE", "golem.SharedAnalogTileFloat")
+tile_arbitration = os.getenv("GOLEM_TILE_ARBITRATION", "roundrobin")  # roundrobin | priority
+
+# mvm.mv.remote: give each RoCC its own router port; peer vectors ride VN 2
+# (memHierarchy NICs inject on VN 0)
+remote_mv = int(os.getenv("GOLEM_REMOTE_MV", 0))
+remote_vn = int(os.getenv("GOLEM_REMOTE_VN", 2))
+
+# Energy table (pJ): "array" and "rocc" sections become element params
+energy_table = os.getenv("GOLEM_ENERGY_TABLE", "")
+
 protocol = "MESI"
 
 # -------------------- OS --------------------
@@ -277,6 +292,8 @@ roccParams = {
     "clock": cpu_clock,
     "verbose": verbosity,
     "max_instructions": 8,
+    # mvm.set / mvm.set.rows / mvm.set.region retire after rows * this
+    "rowProgramLatency": os.getenv("GOLEM_ROW_PROGRAM_LATENCY", "0ns"),
 }
 
 arrayParams = {
@@ -299,6 +316,41 @@ roccParams.update(roccarrayParams)
 arrayParams.update(roccarrayParams)
 roccParams.update(arrayParams)
 
+if energy_table:
+    with open(energy_table) as f:
+        energy = json.load(f)
+    arrayParams.update(energy.get("array", {}))
+    roccParams.update(energy.get("rocc", {}))
+
+# Programmed-array cache: sweep points with the same matrices, JSON and seed
+# reload CrossSim's programmed cores instead of reprogramming them
+program_cache = os.getenv("GOLEM_PROGRAM_CACHE", "")
+if program_cache:
+    os.makedirs(program_cache, exist_ok=True)
+    arrayParams["programCacheDir"] = program_cache
+    arrayParams["programSeed"] = int(os.getenv("GOLEM_PROGRAM_SEED", 0))
+
+# One Python call for all forward MVMs an array bank finishes in the same
+# timestamp (pays off with shared tiles granting several arrays per cycle)
+arrayParams["fuseComputes"] = int(os.getenv("GOLEM_FUSE_COMPUTES", 0))
+arrayParams["pythonThreading"] = os.getenv("GOLEM_PY_THREADING", "inline")
+arrayParams["hostStaged"] = int(os.getenv("GOLEM_HOST_STAGED", 0))
+
+# op_latency (cycles, per opcode) is reported as a histogram
+roccLatencyHistParams = {
+    "type": "sst.HistogramStatistic",
+    "minvalue": "0",
+    "binwidth": "100",
+    "numbins": "50",
+    "IncludeOutOfBounds": "1",
+}
+
+roccNicParams = {
+    "link_bw": "50GB/s",
+    "input_buf_size": "1KB",
+    "output_buf_size": "1KB",
+}
+
 l1dcacheParams = {
     "access_latency_cycles": "2",
     "cache_frequency": cpu_clock,
@@ -384,9 +436,19 @@ class CPU_Builder:
         cpu_rocc = cpu.setSubComponent("rocc", rocc_type, 0)
         cpu_rocc.addParams(roccParams)
         cpu_rocc.enableAllStatistics()
+        cpu_rocc.enableStatistics(["op_latency"], roccLatencyHistParams)
+
+        if cores_per_tile == 1:
+            computeArray = cpu_rocc.setSubComponent("array", array_type)
+            computeArray.addParams(arrayParams)
+            computeArray.enableAllStatistics()
 
-        computeArray = cpu_rocc.setSubComponent("array", array_type)
-        computeArray.addParams(arrayParams)
+        rocc_net = None
+        if remote_mv:
+            cpu_rocc.addParams({"remote_vn": remote_vn, "remote_nid_base": numCpus + 2})
+            roccNic = cpu_rocc.setSubComponent("network_interface", "merlin.linkcontrol")
+            roccNic.addParams(roccNicParams)
+            rocc_net = (roccNic, "rtr_port", "1ns")
 
         # Mem IFs
         cpuDcacheIf = cpu_lsq.setSubComponent("memory_interface", "memHierarchy.standardInterface")
@@ -471,7 +533,7 @@ class CPU_Builder:
         link_bus_l2cache_link.setNoCut()
 
         # Return endpoints to wire outside
-        return (cpu, "os_link", "5ns"), (l2cache_2_mem, "port", "1ns"), (dtlb, "mmu", "1ns"), (itlb, "mmu", "1ns")
+        return (cpu, "os_link", "5ns"), (l2cache_2_mem, "port", "1ns"), (dtlb, "mmu", "1ns"), (itlb, "mmu", "1ns"), (cpu_rocc, "tile", "1ns"), rocc_net
 
 
 def addParamsPrefix(prefix, params):
@@ -507,6 +569,8 @@ link_os_cache_link.connect( (node_os_mem_if, "lowlink", "1ns"), (os_cache, "high
 mesh_wx, mesh_wy = 1, 1
 neighbor_ports = 2 * (mesh_wx + mesh_wy)      # N,S,E,W = 4
 local_ports = numCpus + 2                      # CPUs + DIR + OS = locals
+if remote_mv:
+    local_ports += numCpus                     # RoCC NICs after OS (nid = numCpus + 2 + cpu)
 local_base = neighbor_ports                    # locals start after neighbors
 required_ports = neighbor_ports + local_ports  # total router ports
 
@@ -542,13 +606,35 @@ link_dir_2_mem = sst.Link("link_dir_2_mem")
 link_dir_2_mem.connect((dirtoM, "port", "1ns"), (memToDir, "port", "1ns"))
 link_dir_2_mem.setNoCut()
 
+# -------------------- Shared analog tiles --------------------
+tiles = []
+if cores_per_tile > 1:
+    num_tiles = (numCpus + cores_per_tile - 1) // cores_per_tile
+    for t in range(num_tiles):
+        tile = sst.Component(f"tile{t}", tile_type)
+        tile.addParams(roccarrayParams)
+        tile.addParams({
+            "clock": cpu_clock,
+            "verbose": verbosity,
+            "numPorts": min(cores_per_tile, numCpus - t * cores_per_tile),
+            "numArrays": num_arrays,
+            "arrayInputSize": array_input_size,
+            "arrayOutputSize": array_output_size,
+            "arbitration": tile_arbitration,
+        })
+        tile.enableAllStatistics()
+        tileArray = tile.setSubComponent("array", array_type)
+        tileArray.addParams(arrayParams)
+        tileArray.enableAllStatistics()
+        tiles.append(tile)
+
 # -------------------- Build CPUs + connect to mesh + OS/MMU --------------------
 cpuBuilder = CPU_Builder()
 
 nodeId = 0
 for cpu in range(numCpus):
     prefix = f"node{nodeId}.cpu{cpu}"
-    os_hdlr, l2cache, dtlb, itlb = cpuBuilder.build(prefix, nodeId, cpu)
+    os_hdlr, l2cache, dtlb, itlb, rocc_tile, rocc_net = cpuBuilder.build(prefix, nodeId, cpu)
 
     # MMU -> core TLBs
     link_mmu_dtlb_link = sst.Link(prefix + ".link_mmu_dtlb_link")
@@ -566,6 +652,18 @@ for cpu in range(numCpus):
     link_l2cache_2_rtr.connect(l2cache, (comp_chiprtr, f"port{local_base + cpu}", "1ns"))
     link_l2cache_2_rtr.setNoCut()
 
+    # RoCC front-end -> shared tile port
+    if tiles:
+        link_rocc_tile = sst.Link(prefix + ".link_rocc_tile")
+        link_rocc_tile.connect(rocc_tile, (tiles[cpu // cores_per_tile], f"port{cpu % cores_per_tile}", "1ns"))
+        link_rocc_tile.setNoCut()
+
+    # RoCC NIC -> Router local port (mvm.mv.remote)
+    if rocc_net:
+        link_rocc_2_rtr = sst.Link(prefix + ".link_rocc_2_rtr")
+        link_rocc_2_rtr.connect(rocc_net, (comp_chiprtr, f"port{local_base + numCpus + 2 + cpu}", "1ns"))
+        link_rocc_2_rtr.setNoCut()
+
 # Directory NIC -> Router local port
 link_dir_2_rtr = sst.Link("link_dir_2_rtr")
 link_dir_2_rtr.connect((comp_chiprtr, f"port{local_base + numCpus}", "1ns"), (dirNIC, "port", "1ns"))
@@ -0,0 +1,72 @@
+#!/usr/bin/env python3
+"""Sum SST energy statistics per core from an sst_stats.data console dump.
+
+Usage: energy_report.py sst_stats.data [energy.json]
+
+Analog energies (energy_*) come straight from the RoCC and array statistics.
+If an energy table is given, CPU energy is estimated as retired instructions
+times cpu.instructionEnergy so analog runs can be compared against the
+CPU-only src_baseline solvers on performance-per-watt.
+"""
+
+import json
+import re
+import sys
+from collections import defaultdict
+
+STAT_RE = re.compile(r"^\s*(\S+)\.(energy_\w+|instructions_retired)\s*:.*?Sum\.\w+ = ([-+0-9.eE]+)")
+TIME_RE = re.compile(r"simulated time:\s*([0-9.]+)\s*(\w+)")
+UNITS = {"s": 1.0, "ms": 1e-3, "us": 1e-6, "ns": 1e-9, "ps": 1e-12}
+
+
+def owner(component):
+    m = re.search(r"cpu(\d+)", component)
+    if m:
+        return f"core{m.group(1)}"
+    m = re.match(r"(tile\d+)", component)
+    return m.group(1) if m else "other"
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__)
+        sys.exit(1)
+
+    instr_pJ = 0.0
+    if len(sys.argv) > 2 and sys.argv[2]:
+        with open(sys.argv[2]) as f:
+            instr_pJ = json.load(f).get("cpu", {}).get("instructionEnergy", 0.0)
+
+    energy = defaultdict(lambda: defaultdict(float))
+    sim_time = None
+    with open(sys.argv[1]) as f:
+        for line in f:
+            m = STAT_RE.match(line)
+            if m:
+                comp, stat, value = m.groups()
+                if stat == "instructions_retired":
+                    energy[owner(comp)]["energy_cpu"] += float(value) * instr_pJ
+                else:
+                    energy[owner(comp)][stat] += float(value)
+                continue
+            m = TIME_RE.search(line)
+            if m:
+                sim_time = float(m.group(1)) * UNITS.get(m.group(2), 1.0)
+
+    stats = sorted({s for per in energy.values() for s in per})
+    key = lambda o: (not o.startswith("core"), int(re.sub(r"\D", "", o) or 0), o)
+    print("owner".ljust(10) + "".join(s.rjust(16) for s in stats) + "total_pJ".rjust(16))
+    total = 0.0
+    for o in sorted(energy, key=key):
+        row = sum(energy[o].values())
+        total += row
+        print(o.ljust(10) + "".join(f"{energy[o][s]:16.1f}" for s in stats) + f"{row:16.1f}")
+
+    print(f"\nTotal energy: {total * 1e-12:.6e} J")
+    if sim_time:
+        print(f"Simulated time: {sim_time:.6e} s")
+        print(f"Average power: {total * 1e-12 / sim_time:.6e} W")
+
+
+if __name__ == "__main__":
+    main()
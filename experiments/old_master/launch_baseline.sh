@@ -26,6 +26,9 @@ module load openmpi
 # ================= Params =================== #
 NUM_VCORES_LIST=(16 32 64)
 
+# CPU energy per retired instruction for the perf/W comparison
+ENERGY_TABLE=${ENERGY_TABLE:-"$(pwd)/energy.json"}
+
 SRC_DIR=${SRC_DIR:-"$(pwd)/src_baseline"}
 CONFIG_DIR=${CONFIG_DIR:-"$(pwd)/configs_baseline"}
 
@@ -94,6 +97,7 @@ export VANADIS_EXE="$ROOT/experiment/$TARGET_EXE"
 cp $CONFIG_FILE $RESULTS_DIR/.
 pushd $RESULTS_DIR
     sst "$CONFIG_NAME.py" > "sst_stats.data"
+    python3 "$OLDPWD/energy_report.py" "sst_stats.data" "$ENERGY_TABLE" > "energy.txt" || true
 popd
 echo "  Done → $RESULTS_DIR"
 
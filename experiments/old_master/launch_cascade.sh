@@ -0,0 +1,98 @@
+#!/usr/bin/env bash
+set -eo pipefail
+
+# Simulated time of src_cascade/cascade_bench.cpp with mvm.mv cascades vs the
+# same chains through memory: one SST run per mode, same binary and config.
+
+# ================= Compiler ================= #
+export ROOT="$(realpath "$(pwd)"/..)"
+export BUILD_DEST="$ROOT/build"
+COMPILER="$BUILD_DEST/llvm-project/bin/clang++"
+TARGET="riscv64-unknown-linux-musl"
+TOOLCHAIN="$BUILD_DEST/riscv-gnu-toolchain"
+SYSROOT="$TOOLCHAIN/sysroot"
+
+RCC="riscv64-unknown-linux-musl-g++"
+RCXX_FLAGS="-static -fopenmp"
+
+CC="$COMPILER --target=$TARGET --gcc-toolchain=$TOOLCHAIN --sysroot=$SYSROOT"
+CXX_FLAGS="-static"
+
+
+# ================= SST Setup ================ #
+export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$BUILD_DEST/python3.11/lib:$BUILD_DEST/isl/lib"
+export PATH="$PATH:$BUILD_DEST/python3.11/bin:$BUILD_DEST/llvm-project/bin:$BUILD_DEST/sst-core/bin"
+export PATH="$PATH:$TOOLCHAIN/bin"
+module load openmpi
+
+
+# ================= Params =================== #
+export GOLEM_ARRAY_TYPE="golem.CrossSimFloatArray"
+
+export GOLEM_NUM_ARRAYS=${GOLEM_NUM_ARRAYS:-4}
+export VANADIS_NUM_CORES=${VANADIS_NUM_CORES:-4}
+export GOLEM_CORES_PER_TILE=1
+export ARRAY_INPUT_SIZE=128
+export ARRAY_OUTPUT_SIZE=128
+export GOLEM_ENERGY_TABLE=${GOLEM_ENERGY_TABLE-"$(pwd)/energy.json"}
+export GOLEM_PROGRAM_CACHE=""
+
+CPP_FILE=${CPP_FILE:-"$(pwd)/src_cascade/cascade_bench.cpp"}
+CONFIG_FILE=${CONFIG_FILE:-"$(pwd)/configs/small.py"}
+DEPTH=${DEPTH:-8}
+BATCH=${BATCH:-64}
+
+MODE_LIST=(cascade memory)
+
+ALGORITHM_NAME="$(basename "$CPP_FILE" .cpp)"
+CONFIG_NAME="$(basename "$CONFIG_FILE" .py)"
+RESULTS_DIR="results/cascade/${ALGORITHM_NAME}-${GOLEM_NUM_ARRAYS}-${VANADIS_NUM_CORES}-d${DEPTH}-b${BATCH}-${CONFIG_NAME}"
+mkdir -p $RESULTS_DIR
+
+TARGET_EXE="$RESULTS_DIR/${ALGORITHM_NAME}.exe"
+
+
+echo "Cascade bench: $ALGORITHM_NAME"
+echo "  Num arrays: $GOLEM_NUM_ARRAYS"
+echo "  Num cores: $VANADIS_NUM_CORES"
+echo "  Depth x batch: ${DEPTH}x${BATCH}"
+echo "  Config: $CONFIG_NAME"
+
+
+# analog/intrinsics.h operand footprints follow the array geometry
+ANALOG_FLAGS="-I$(pwd) -DANALOG_TILE_ROWS=$ARRAY_OUTPUT_SIZE -DANALOG_TILE_COLS=$ARRAY_INPUT_SIZE"
+
+# ================= Build ================= #
+
+$CC $CXX_FLAGS $ANALOG_FLAGS -c kernel.cpp -o kernel.o
+
+$RCC $RCXX_FLAGS $ANALOG_FLAGS \
+  -DNUM_ARRAYS="$GOLEM_NUM_ARRAYS" \
+  -DNUM_CORES="$VANADIS_NUM_CORES" \
+  -DCORES_PER_TILE="$GOLEM_CORES_PER_TILE" \
+  -DDEPTH="$DEPTH" \
+  -DBATCH="$BATCH" \
+  "$CPP_FILE" kernel.o -o "$TARGET_EXE"
+
+echo "  Build: OK"
+
+export VANADIS_EXE="$(realpath "$TARGET_EXE")"
+cp $CONFIG_FILE $RESULTS_DIR/.
+
+
+# ================= Run ================= #
+
+CSV="$RESULTS_DIR/cascade_bench.csv"
+echo "mode,simulated_time" > "$CSV"
+
+pushd $RESULTS_DIR
+for mode in "${MODE_LIST[@]}"; do
+  export VANADIS_EXE_ARGS=$mode
+  sst "$CONFIG_NAME.py" > "sst_stats-${mode}.data"
+  sim=$(grep -o "simulated time: .*" "sst_stats-${mode}.data" | tail -n 1 | cut -d' ' -f3-)
+  echo "$mode,$sim" >> "$(basename "$CSV")"
+  echo "  $mode: $sim"
+done
+popd
+
+echo "  Done → $CSV"
@@ -30,6 +30,26 @@ export GOLEM_ARRAY_TYPE="golem.CrossSimFloatArray"
 NUM_ARRAYS_LIST=(64 32 16 8 4 2 1)
 NUM_VCORES_LIST=(1  2  4  8 16 32 64)
 
+# Cores sharing one array pool (1 = private arrays per core). With sharing,
+# NUM_ARRAYS_LIST is the pool size per tile.
+export GOLEM_CORES_PER_TILE=${GOLEM_CORES_PER_TILE:-1}
+
+# Arrays each core's AnalogMatrix may hold (0 = whole pool). Below the tile
+# count, tiles are swapped in with mvm.set (LRU) instead of refusing to run.
+export GOLEM_ARRAYS_PER_CORE=${GOLEM_ARRAYS_PER_CORE:-0}
+
+# 1 = program tiles as A/max|A_tile| and let the coprocessor rescale outputs
+# through its mvm.cfg registers (float arrays only)
+export GOLEM_SCALE_REGS=${GOLEM_SCALE_REGS:-0}
+
+# pJ table for array/RoCC energy statistics (empty disables the energy model)
+export GOLEM_ENERGY_TABLE=${GOLEM_ENERGY_TABLE-"$(pwd)/energy.json"}
+
+# Programmed-array cache shared by every sweep point, e.g. $(pwd)/program_cache
+# (empty disables it)
+export GOLEM_PROGRAM_CACHE=${GOLEM_PROGRAM_CACHE-""}
+export GOLEM_PROGRAM_SEED=${GOLEM_PROGRAM_SEED:-0}
+
 SRC_DIR=${SRC_DIR:-"$(pwd)/src_master"}
 CONFIG_DIR=${CONFIG_DIR:-"$(pwd)/configs"}
 
@@ -73,6 +93,15 @@ CONFIG_FILE="${CONFIG_FILES[$i_conf]}"
 CONFIG_NAME="$(basename "$CONFIG_FILE" .py)"
 
 TRIAL_NAME="${ALGORITHM_NAME}-${GOLEM_NUM_ARRAYS}-${VANADIS_NUM_CORES}-${CONFIG_NAME}"
+if (( GOLEM_CORES_PER_TILE > 1 )); then
+  TRIAL_NAME="${TRIAL_NAME}-tile${GOLEM_CORES_PER_TILE}"
+fi
+if (( GOLEM_ARRAYS_PER_CORE > 0 )); then
+  TRIAL_NAME="${TRIAL_NAME}-cap${GOLEM_ARRAYS_PER_CORE}"
+fi
+if (( GOLEM_SCALE_REGS > 0 )); then
+  TRIAL_NAME="${TRIAL_NAME}-sregs"
+fi
 
 export GOLEM_NUM_ARRAYS="${NUM_ARRAYS_LIST[$i_pair]}"
 export VANADIS_NUM_CORES="${NUM_VCORES_LIST[$i_pair]}"
@@ -88,19 +117,26 @@ TARGET_EXE="$RESULTS_DIR/${TRIAL_NAME}.exe"
 echo "Trial: $TRIAL_NAME"
 echo "  Algorithm: $ALGORITHM_NAME"
 echo "  Num arrays: $GOLEM_NUM_ARRAYS"
+echo "  Cores/tile: $GOLEM_CORES_PER_TILE"
 echo "  Size: ${ARRAY_INPUT_SIZE}x${ARRAY_OUTPUT_SIZE}"
 echo "  Source: $CPP_FILE"
 echo "  Target: $TARGET_EXE"
 echo "  Config: $CONFIG_NAME"
 
 
+# analog/intrinsics.h operand footprints follow the array geometry
+ANALOG_FLAGS="-I$(pwd) -DANALOG_TILE_ROWS=$ARRAY_OUTPUT_SIZE -DANALOG_TILE_COLS=$ARRAY_INPUT_SIZE"
+
 # ================= Build & Run ================= #
 
-$CC $CXX_FLAGS -c kernel.cpp -o kernel.o
+$CC $CXX_FLAGS $ANALOG_FLAGS -c kernel.cpp -o kernel.o
 
-$RCC $RCXX_FLAGS \
+$RCC $RCXX_FLAGS $ANALOG_FLAGS \
   -DNUM_ARRAYS="$GOLEM_NUM_ARRAYS" \
   -DNUM_CORES="$VANADIS_NUM_CORES" \
+  -DCORES_PER_TILE="$GOLEM_CORES_PER_TILE" \
+  -DARRAYS_PER_CORE="$GOLEM_ARRAYS_PER_CORE" \
+  -DSCALE_REGS="$GOLEM_SCALE_REGS" \
   "$CPP_FILE" kernel.o -o "$TARGET_EXE"
 
 echo "  Build: OK"
@@ -109,6 +145,7 @@ export VANADIS_EXE="$ROOT/experiment/$TARGET_EXE"
 cp $CONFIG_FILE $RESULTS_DIR/.
 pushd $RESULTS_DIR
     sst "$CONFIG_NAME.py" > "sst_stats.data"
+    python3 "$OLDPWD/energy_report.py" "sst_stats.data" "$GOLEM_ENERGY_TABLE" > "energy.txt" || true
 popd
 echo "  Done → $RESULTS_DIR"
 
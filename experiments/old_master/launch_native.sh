@@ -0,0 +1,54 @@
+#!/usr/bin/env bash
+set -eo pipefail
+
+# Host build of the master solvers against analog/emulator.h: no SST, no
+# RISC-V toolchain. Useful for checking numerics and op counts before a sweep.
+# Noise/ADC/cost knobs are the ANALOG_EMU_* variables in analog/emulator.h.
+
+# ================= Compiler ================= #
+HOST_CXX=${HOST_CXX:-g++}
+HOST_CXX_FLAGS=${HOST_CXX_FLAGS:-"-O2 -fopenmp"}
+
+
+# ================= Params =================== #
+export GOLEM_NUM_ARRAYS=${GOLEM_NUM_ARRAYS:-8}
+export VANADIS_NUM_CORES=${VANADIS_NUM_CORES:-8}
+export GOLEM_CORES_PER_TILE=${GOLEM_CORES_PER_TILE:-1}
+export GOLEM_ARRAYS_PER_CORE=${GOLEM_ARRAYS_PER_CORE:-0}
+export ARRAY_INPUT_SIZE=${ARRAY_INPUT_SIZE:-128}
+export ARRAY_OUTPUT_SIZE=${ARRAY_OUTPUT_SIZE:-128}
+
+SRC_DIR=${SRC_DIR:-"$(pwd)/src_master"}
+
+shopt -s nullglob
+mapfile -t CPP_FILES < <(printf '%s\n' "$SRC_DIR"/*.cpp)
+shopt -u nullglob
+
+if (( ${#CPP_FILES[@]} == 0 )); then
+  echo "No CPP files found. SRC_DIR='$SRC_DIR'"; exit 1
+fi
+
+RESULTS_DIR="results/native-${GOLEM_NUM_ARRAYS}-${VANADIS_NUM_CORES}"
+mkdir -p $RESULTS_DIR
+
+ANALOG_FLAGS="-I$(pwd) -DANALOG_EMULATE -DANALOG_TILE_ROWS=$ARRAY_OUTPUT_SIZE -DANALOG_TILE_COLS=$ARRAY_INPUT_SIZE"
+
+# ================= Build & Run ================= #
+export OMP_NUM_THREADS=$VANADIS_NUM_CORES
+
+for CPP_FILE in "${CPP_FILES[@]}"; do
+  ALGORITHM_NAME="$(basename "$CPP_FILE" .cpp)"
+  TARGET_EXE="$RESULTS_DIR/${ALGORITHM_NAME}"
+
+  echo "Native: $ALGORITHM_NAME (${GOLEM_NUM_ARRAYS} arrays, ${VANADIS_NUM_CORES} cores)"
+  $HOST_CXX $HOST_CXX_FLAGS $ANALOG_FLAGS \
+    -DNUM_ARRAYS="$GOLEM_NUM_ARRAYS" \
+    -DNUM_CORES="$VANADIS_NUM_CORES" \
+    -DCORES_PER_TILE="$GOLEM_CORES_PER_TILE" \
+    -DARRAYS_PER_CORE="$GOLEM_ARRAYS_PER_CORE" \
+    "$CPP_FILE" -o "$TARGET_EXE"
+
+  "$TARGET_EXE" > "$RESULTS_DIR/${ALGORITHM_NAME}.out" 2> "$RESULTS_DIR/${ALGORITHM_NAME}.emu"
+  tail -n 1 "$RESULTS_DIR/${ALGORITHM_NAME}.out"
+done
+echo "  Done → $RESULTS_DIR"
@@ -0,0 +1,103 @@
+#!/usr/bin/env bash
+set -eo pipefail
+
+# Wall-clock comparison of the CrossSimComputeArray policies on one kernel:
+# every pythonThreading mode x hostStaged, same binary and config.
+
+# ================= Compiler ================= #
+export ROOT="$(realpath "$(pwd)"/..)"
+export BUILD_DEST="$ROOT/build"
+COMPILER="$BUILD_DEST/llvm-project/bin/clang++"
+TARGET="riscv64-unknown-linux-musl"
+TOOLCHAIN="$BUILD_DEST/riscv-gnu-toolchain"
+SYSROOT="$TOOLCHAIN/sysroot"
+
+RCC="riscv64-unknown-linux-musl-g++"
+RCXX_FLAGS="-static -fopenmp"
+
+CC="$COMPILER --target=$TARGET --gcc-toolchain=$TOOLCHAIN --sysroot=$SYSROOT"
+CXX_FLAGS="-static"
+
+
+# ================= SST Setup ================ #
+export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$BUILD_DEST/python3.11/lib:$BUILD_DEST/isl/lib"
+export PATH="$PATH:$BUILD_DEST/python3.11/bin:$BUILD_DEST/llvm-project/bin:$BUILD_DEST/sst-core/bin"
+export PATH="$PATH:$TOOLCHAIN/bin"
+module load openmpi
+
+
+# ================= Params =================== #
+export GOLEM_ARRAY_TYPE="golem.CrossSimFloatArray"
+
+export GOLEM_NUM_ARRAYS=${GOLEM_NUM_ARRAYS:-8}
+export VANADIS_NUM_CORES=${VANADIS_NUM_CORES:-8}
+export GOLEM_CORES_PER_TILE=1
+export ARRAY_INPUT_SIZE=128
+export ARRAY_OUTPUT_SIZE=128
+export GOLEM_ENERGY_TABLE=""
+export GOLEM_PROGRAM_CACHE=""
+
+CPP_FILE=${CPP_FILE:-"$(pwd)/src_master/cg_master.cpp"}
+CONFIG_FILE=${CONFIG_FILE:-"$(pwd)/configs/small.py"}
+REPEATS=${REPEATS:-3}
+
+THREADING_LIST=(inline gil worker)
+STAGED_LIST=(0 1)
+
+ALGORITHM_NAME="$(basename "$CPP_FILE" .cpp)"
+CONFIG_NAME="$(basename "$CONFIG_FILE" .py)"
+RESULTS_DIR="results/policy_bench/${ALGORITHM_NAME}-${GOLEM_NUM_ARRAYS}-${VANADIS_NUM_CORES}-${CONFIG_NAME}"
+mkdir -p $RESULTS_DIR
+
+TARGET_EXE="$RESULTS_DIR/${ALGORITHM_NAME}.exe"
+
+
+echo "Policy bench: $ALGORITHM_NAME"
+echo "  Num arrays: $GOLEM_NUM_ARRAYS"
+echo "  Num cores: $VANADIS_NUM_CORES"
+echo "  Config: $CONFIG_NAME"
+echo "  Repeats: $REPEATS"
+
+
+# analog/intrinsics.h operand footprints follow the array geometry
+ANALOG_FLAGS="-I$(pwd) -DANALOG_TILE_ROWS=$ARRAY_OUTPUT_SIZE -DANALOG_TILE_COLS=$ARRAY_INPUT_SIZE"
+
+# ================= Build ================= #
+
+$CC $CXX_FLAGS $ANALOG_FLAGS -c kernel.cpp -o kernel.o
+
+$RCC $RCXX_FLAGS $ANALOG_FLAGS \
+  -DNUM_ARRAYS="$GOLEM_NUM_ARRAYS" \
+  -DNUM_CORES="$VANADIS_NUM_CORES" \
+  -DCORES_PER_TILE="$GOLEM_CORES_PER_TILE" \
+  "$CPP_FILE" kernel.o -o "$TARGET_EXE"
+
+echo "  Build: OK"
+
+export VANADIS_EXE="$(realpath "$TARGET_EXE")"
+cp $CONFIG_FILE $RESULTS_DIR/.
+
+
+# ================= Sweep ================= #
+
+CSV="$RESULTS_DIR/policy_bench.csv"
+echo "threading,host_staged,repeat,seconds" > "$CSV"
+
+pushd $RESULTS_DIR
+for threading in "${THREADING_LIST[@]}"; do
+  for staged in "${STAGED_LIST[@]}"; do
+    for (( r=0; r<REPEATS; r++ )); do
+      export GOLEM_PY_THREADING=$threading
+      export GOLEM_HOST_STAGED=$staged
+      start=$(date +%s.%N)
+      sst "$CONFIG_NAME.py" > "sst_stats-${threading}-${staged}.data"
+      end=$(date +%s.%N)
+      secs=$(echo "$end - $start" | bc)
+      echo "$threading,$staged,$r,$secs" >> "$(basename "$CSV")"
+      echo "  $threading staged=$staged run $r: ${secs}s"
+    done
+  done
+done
+popd
+
+echo "  Done → $CSV"
@@ -42,7 +42,7 @@ echo "  Size: ${ARRAY_INPUT_SIZE}x${ARRAY_OUTPUT_SIZE}"
 echo "  Source: $CPP_FILE"
 echo "  Target: $TARGET_EXE"
 
-$CC $CXX_FLAGS -c kernel.cpp -o kernel.o
+$CC $CXX_FLAGS -DANALOG_TILE_ROWS=$ARRAY_OUTPUT_SIZE -DANALOG_TILE_COLS=$ARRAY_INPUT_SIZE -c kernel.cpp -o kernel.o
 $RCC $RCXX_FLAGS \
   -DINPUT_SIZE="$INPUT_SIZE" \
   -DNUM_ARRAYS="$GOLEM_NUM_ARRAYS" \
@@ -0,0 +1,90 @@
+// cascade_bench.cpp: mvm.mv cascades vs the same chains through memory
+//
+//   chain  DEPTH square single-tile layers, y = W_{d-1}*(...*(W_0*x))
+//   mlp    the same layers with ReLU between them, except every other one
+//
+// argv[1] selects "cascade", "memory" or "both" (default). Under SST run one
+// mode per simulation and compare simulated times (launch_cascade.sh); on the
+// host emulator both modes run in one process and report modelled time.
+#include <omp.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifndef CORES_PER_TILE
+#define CORES_PER_TILE 1
+#endif
+
+#ifndef DEPTH
+#define DEPTH 8           // layers per chain
+#endif
+
+#ifndef BATCH
+#define BATCH 64          // vectors pushed through each chain
+#endif
+
+#include "analog/cascade.h"
+
+static double run(const char* name, const std::vector<analog::Layer>& layers, bool cascade,
+                  const float* X, float* Y, int n) {
+    analog::CascadeOptions opt;
+    opt.cascade = cascade;
+    analog::AnalogCascade chain(layers, opt);
+
+#ifdef ANALOG_EMULATE
+    // Host wall time mostly measures the emulator; report its cost model
+    const double t0 = analog::emu::Emulator::get().total_ns() * 1e-9;
+    chain.apply(X, BATCH, n, Y, n);
+    const double t = analog::emu::Emulator::get().total_ns() * 1e-9 - t0;
+#else
+    const double t0 = omp_get_wtime();
+    chain.apply(X, BATCH, n, Y, n);
+    const double t = omp_get_wtime() - t0;
+#endif
+
+    std::cout << name << (cascade ? " cascade" : " memory") << ": " << t << " s\n";
+    chain.print_stats();
+    return t;
+}
+
+int main(int argc, char** argv){
+    const char* mode = argc > 1 ? argv[1] : "both";
+    const bool do_cascade = std::strcmp(mode, "memory") != 0;
+    const bool do_memory  = std::strcmp(mode, "cascade") != 0;
+
+    const int n = std::min(analog::TILE_ROWS, analog::TILE_COLS);
+
+    // Scaled so the activations stay O(1) down the chain
+    std::mt19937 gen(7);
+    std::normal_distribution<float> dist(0.0f, 1.0f / std::sqrt(static_cast<float>(n)));
+    std::vector<float> W(static_cast<size_t>(DEPTH) * n * n);
+    for (float& w : W) w = dist(gen);
+
+    std::vector<analog::Layer> chain, mlp;
+    for (int l = 0; l < DEPTH; ++l) {
+        analog::Layer L{ W.data() + static_cast<size_t>(l) * n * n, n, n, n };
+        chain.push_back(L);
+        if (l % 2 == 1 && l + 1 < DEPTH) L.act = analog::Activation::ReLU;
+        mlp.push_back(L);
+    }
+
+    std::vector<float> X(static_cast<size_t>(BATCH) * n), Yc(X.size()), Ym(X.size());
+    for (float& x : X) x = dist(gen) * std::sqrt(static_cast<float>(n));
+
+    const std::vector<analog::Layer>* cases[] = { &chain, &mlp };
+    const char* names[] = { "chain", "mlp" };
+    for (int i = 0; i < 2; ++i) {
+        double tc = 0, tm = 0;
+        if (do_cascade) tc = run(names[i], *cases[i], true,  X.data(), Yc.data(), n);
+        if (do_memory)  tm = run(names[i], *cases[i], false, X.data(), Ym.data(), n);
+        if (do_cascade && do_memory) {
+            float diff = 0;
+            for (size_t j = 0; j < Yc.size(); ++j) diff = std::max(diff, std::fabs(Yc[j] - Ym[j]));
+            std::cout << names[i] << " speedup: " << tm / tc << "x, max diff " << diff << "\n";
+        }
+    }
+    return 0;
+}
@@ -1,110 +1,29 @@
 // BiCGSTAB with persistent analog MVM tiles (8x8 of 128x128)
 #include <omp.h>
-#include <sched.h>
-#include <unistd.h>
 #include <cstring>
 #include <cmath>
 #include <cstdint>
 #include <iostream>
 #include <algorithm>
 
-extern "C" {
-    uint64_t mvm_set (const void* A, int tile_id);
-    uint64_t mvm_load(const void* x, int tile_id);
-    uint64_t mvm_exec(int tile_id);
-    uint64_t mvm_store(void* y, int tile_id);
-}
-
-static inline void pin_thread_to_core(int core){
-    cpu_set_t m; CPU_ZERO(&m); CPU_SET(core, &m);
-    sched_setaffinity(0, sizeof(m), &m);
-}
+#ifndef USE_BCAST
+#define USE_BCAST 1        // one mvm.l.bcast per column tile instead of an mvm.l per array
+#endif
 
-static inline float dot(const float* a, const float* b, int n){
-    float s=0.0f; for(int i=0;i<n;++i) s+=a[i]*b[i]; return s;
-}
-static inline void axpy(float* y, const float* x, float a, int n){
-    for(int i=0;i<n;++i) y[i]+=a*x[i];
-}
-static inline void xmy(float* y, const float* x, float a, int n){
-    for(int i=0;i<n;++i) y[i]-=a*x[i];
-}
+#ifndef CORES_PER_TILE
+#define CORES_PER_TILE 1   // cores sharing one pool of NUM_ARRAYS arrays
+#endif
 
-static inline void fill_chunks_from_A(const float* A, float** chunks){
-    constexpr int N=1024, T=128, G=8; // 64 tiles, row-major 8x8
-//    constexpr int N=512, T=64, G=8; // 64 tiles, row-major 8x8
-//    constexpr int N=16, T=2, G=8; 
-    for(int k=0;k<64;++k){
-        int tr=k/G, tc=k%G;
-        const float* src0=A + tr*T*N + tc*T;
-        float* dst=chunks[k];
-        for(int r=0;r<T;++r) std::memcpy(dst + r*T, src0 + r*N, T*sizeof(float));
-    }
-}
+#ifndef ARRAYS_PER_CORE
+#define ARRAYS_PER_CORE 0  // arrays each core may use (0 = whole pool); fewer than its tiles swaps them in
+#endif
 
-// ---- stage once, persistent ----
-static inline void stage_tiles_persistent(float** chunks){
-    if (NUM_CORES * NUM_ARRAYS < 64) {
-        std::cerr << "Error: NUM_CORES*NUM_ARRAYS must be >= 64 for persistent staging.\n";
-        std::exit(1);
-    }
-    omp_set_num_threads(NUM_CORES);
-    #pragma omp parallel
-    {
-        int tid = omp_get_thread_num();
-        pin_thread_to_core(tid);
-        int nth = omp_get_num_threads();
-        for(int k=tid; k<64; k+=nth){
-            int arr = k / nth; // match apply_Ax mapping (arr = k / NUM_CORES)
-            mvm_set(chunks[k], arr);
-        }
-        #pragma omp barrier
-    }
-}
+#ifndef SCALE_REGS
+#define SCALE_REGS 0       // per-tile max|A| scaling, outputs rescaled by the coprocessor (mvm.cfg)
+#endif
 
-// ---- y = A*x using staged tiles ----
-static inline void apply_Ax_persistent(const float* x, float* y){
-    constexpr int G=8, T=128, N=1024;
-//    constexpr int G=8, T=64, N=512;
-//    constexpr int G=8, T=2, N=16;
-    float* partials = new float[NUM_CORES * N](); // per-thread accumulators
-    float* scratch  = new float[NUM_CORES * T]();
-
-    omp_set_num_threads(NUM_CORES);
-    #pragma omp parallel 
-    {
-        int tid = omp_get_thread_num();
-        pin_thread_to_core(tid);
-        float* part = partials + tid * N;
-        float* tmp  = scratch  + tid * T;
-
-        for(int k=tid; k<64; k+=NUM_CORES){
-            int tr  = k / G;          // row tile
-            int tc  = k % G;          // col tile
-            int arr = k / NUM_CORES;  // array slot used at stage
-
-            mvm_load(x + tc*T, arr);
-            mvm_exec(arr);
-            mvm_store(tmp, arr);
-
-            float* dst = part + tr*T;
-            for(int i=0;i<T;++i) dst[i] += tmp[i];
-        }
-        #pragma omp barrier
-    }
-
-    std::memset(y, 0, N*sizeof(float));
-    for(int t=0;t<NUM_CORES;++t){
-        const float* part = partials + t*1024;
-        for(int i=0;i<1024;++i) y[i] += part[i];
-//        const float* part = partials + t*512;
-//        for(int i=0;i<512;++i) y[i] += part[i];
-//        const float* part = partials + t*16;
-//        for(int i=0;i<16;++i) y[i] += part[i];
-    }
-    delete[] scratch;
-    delete[] partials;
-}
+#include "analog/blas.h"   // AnalogMatrix: tiling, placement, gemv
+#include "analog/team.h"   // BLAS-1 over the matrix's row partition (RVV with -march=rv64gcv)
 
 int main(){
     constexpr int n=1024;
@@ -121,76 +40,87 @@ int main(){
     }
     for(int i=0;i+1<n;++i) A[i*n + (i+1)] -= 0.2f; // slight skew
 
-    // Vectors
-    float *b=new float[n], *x=new float[n];
-    for(int i=0;i<n;++i){ b[i]=1.0f; x[i]=0.0f; }
-
-    // Tiles (8×8 of 128×128)
-    float** chunks = new float*[64];
-    for(int k=0;k<64;++k) chunks[k] = new float[128*128]();
-//    for(int k=0;k<64;++k) chunks[k] = new float[64*64]();
-//    for(int k=0;k<64;++k) chunks[k] = new float[2*2]();
-    fill_chunks_from_A(A, chunks);
-    stage_tiles_persistent(chunks);
+    // Tile, place and program A once (8×8 tiles of 128×128 for n=1024)
+    analog::Options opt;
+    opt.bcast = USE_BCAST;
+    opt.arrays_per_core = ARRAYS_PER_CORE;
+    opt.scale_regs = SCALE_REGS;
+    analog::AnalogMatrix Am(A, n, n, n, opt);
 
-    // BiCGSTAB data
+    analog::Team team(Am.row_partition());
+    float *b=new float[n], *x=new float[n];
     float *r=new float[n], *rhat=new float[n], *p=new float[n], *v=new float[n], *s=new float[n], *t=new float[n];
-
-    // r = b - A*x
-    apply_Ax_persistent(x, v);
-    for(int i=0;i<n;++i) r[i]=b[i]-v[i];
-    for(int i=0;i<n;++i) rhat[i]=r[i];
-    for(int i=0;i<n;++i){ p[i]=0.0f; v[i]=0.0f; }
-
-    float rho_old=1.0f, alpha=1.0f, omega=1.0f;
-    const float bnorm = std::max(1.0f, std::sqrt(dot(b,b,n)));
-    const float tol = 1e-3f, tol_abs = tol * bnorm, eps = 1e-30f;
-    float r_norm;
-
-    const int maxit=10;
+    float r_norm=0.0f;
     int k=0;
-    while(k<maxit){
-        float rho_new = dot(rhat, r, n);
-        if (std::fabs(rho_new) < eps) { k=-1; break; }
-
-        float beta = (rho_new/(rho_old+eps))*(alpha/(omega+eps));
-        for(int i=0;i<n;++i) p[i] = r[i] + beta*(p[i] - omega*v[i]);
-
-        apply_Ax_persistent(p, v);                          // v = A*p
-        float rhat_v = dot(rhat, v, n);
-        if (std::fabs(rhat_v) < eps) { k=-1; break; }
-        alpha = rho_new / rhat_v;
-
-        for(int i=0;i<n;++i) s[i] = r[i] - alpha*v[i];
-        float s_norm = std::sqrt(dot(s,s,n));
-        if (s_norm <= tol_abs){
-            axpy(x, p, alpha, n);
-            ++k; break;
-        }
-
-        apply_Ax_persistent(s, t);                          // t = A*s
-        float tt = dot(t,t,n);
-        if (std::fabs(tt) < eps) { k=-1; break; }
-        omega = dot(t,s,n)/tt;
-        if (std::fabs(omega) < eps) { k=-1; break; }
 
-        for(int i=0;i<n;++i) x[i] += alpha*p[i] + omega*s[i];
-        for(int i=0;i<n;++i) r[i]  = s[i] - omega*t[i];
-
-        r_norm = std::sqrt(dot(r,r,n));
-        ++k;
-        if (r_norm <= tol_abs) break;
+    // One team for the whole solve: each thread owns its rows of every
+    // vector, computes the same scalars, and syncs only in reductions and MVMs
+    #pragma omp parallel num_threads(team.parts())
+    {
+        analog::pin_self(omp_get_thread_num());
+        team.fill(b, 1.0f);                                     // first touch by the owning thread
+        team.fill(x, 0.0f);
+        team.fill(s, 0.0f);
+        team.fill(t, 0.0f);
+
+        // r = b - A*x
+        Am.gemv(x, v);
+        team.sub(r, b, v);
+        team.copy(rhat, r);
+        team.fill(p, 0.0f);
+        team.fill(v, 0.0f);
+
+        float rho_old=1.0f, alpha=1.0f, omega=1.0f;
+        const float bnorm = std::max(1.0f, team.norm2(b));
+        const float tol = 1e-3f, tol_abs = tol * bnorm, eps = 1e-30f;
+        float rn=0.0f;
+
+        const int maxit=10;
+        int it=0;
+        while(it<maxit){
+            float rho_new = team.dot(rhat, r);
+            if (std::fabs(rho_new) < eps) { it=-1; break; }
+
+            float beta = (rho_new/(rho_old+eps))*(alpha/(omega+eps));
+            team.bicg_p(p, r, v, beta, omega);                  // p = r + beta*(p - omega*v)
+
+            Am.gemv(p, v);                                      // v = A*p
+            float rhat_v = team.dot(rhat, v);
+            if (std::fabs(rhat_v) < eps) { it=-1; break; }
+            alpha = rho_new / rhat_v;
+
+            float s_norm = std::sqrt(team.bicg_s(s, r, v, alpha)); // s = r - alpha*v
+            if (s_norm <= tol_abs){
+                team.axpy(x, p, alpha);
+                ++it; break;
+            }
+
+            Am.gemv(s, t);                                      // t = A*s
+            float tt, ts;
+            team.dot2(t, s, tt, ts);
+            if (std::fabs(tt) < eps) { it=-1; break; }
+            omega = ts/tt;
+            if (std::fabs(omega) < eps) { it=-1; break; }
+
+            // x += alpha*p + omega*s, r = s - omega*t
+            rn = std::sqrt(team.bicg_xr(x, r, p, s, t, alpha, omega));
+            ++it;
+            if (rn <= tol_abs) break;
+
+            rho_old = rho_new;
+            #pragma omp master
+            std::cout << "r_norm: " << rn << std::endl;
+        }
 
-        rho_old = rho_new;
-	std::cout << "r_norm: " << r_norm << std::endl;
+        #pragma omp master
+        { r_norm = rn; k = it; }
     }
 
     std::cout << "Fin-r_norm: " << r_norm << std::endl;
     std::cout << "BiCGSTAB iters: " << k << "\n";
+    Am.print_stats();
 
     // cleanup
-    for(int i=0;i<64;++i) delete[] chunks[i];
-    delete[] chunks;
     delete[] A; delete[] b; delete[] x;
     delete[] r; delete[] rhat; delete[] p; delete[] v; delete[] s; delete[] t;
     return 0;
@@ -0,0 +1,67 @@
+#!/usr/bin/env bash
+set -eo pipefail
+
+# Host check that the master solvers' results do not depend on the core
+# count: every src_master solver is built against analog/emulator.h for each
+# (arrays, cores) pair of launch_master.sh and its final residual line
+# ("Fin-...") must be identical across pairs. Exits non-zero on a mismatch.
+
+# ================= Compiler ================= #
+HOST_CXX=${HOST_CXX:-g++}
+HOST_CXX_FLAGS=${HOST_CXX_FLAGS:-"-O2 -fopenmp"}
+
+
+# ================= Params =================== #
+# Same pairs as launch_master.sh
+NUM_ARRAYS_LIST=(64 32 16 8 4 2 1)
+NUM_VCORES_LIST=(1  2  4  8 16 32 64)
+
+export ARRAY_INPUT_SIZE=${ARRAY_INPUT_SIZE:-128}
+export ARRAY_OUTPUT_SIZE=${ARRAY_OUTPUT_SIZE:-128}
+export ANALOG_EMU_REPORT=0
+
+SRC_DIR=${SRC_DIR:-"$(pwd)/src_master"}
+
+shopt -s nullglob
+mapfile -t CPP_FILES < <(printf '%s\n' "$SRC_DIR"/*.cpp)
+shopt -u nullglob
+
+if (( ${#CPP_FILES[@]} == 0 )); then
+  echo "No CPP files found. SRC_DIR='$SRC_DIR'"; exit 1
+fi
+
+BUILD_DIR=$(mktemp -d)
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+ANALOG_FLAGS="-I$(pwd) -DANALOG_EMULATE -DANALOG_TILE_ROWS=$ARRAY_OUTPUT_SIZE -DANALOG_TILE_COLS=$ARRAY_INPUT_SIZE"
+
+# ================= Build & Compare ================= #
+FAILED=0
+for CPP_FILE in "${CPP_FILES[@]}"; do
+  ALGORITHM_NAME="$(basename "$CPP_FILE" .cpp)"
+  REF=""
+  for i in "${!NUM_ARRAYS_LIST[@]}"; do
+    ARRAYS="${NUM_ARRAYS_LIST[$i]}"
+    CORES="${NUM_VCORES_LIST[$i]}"
+    TARGET_EXE="$BUILD_DIR/${ALGORITHM_NAME}-${ARRAYS}-${CORES}"
+
+    $HOST_CXX $HOST_CXX_FLAGS $ANALOG_FLAGS \
+      -DNUM_ARRAYS="$ARRAYS" \
+      -DNUM_CORES="$CORES" \
+      "$CPP_FILE" -o "$TARGET_EXE"
+
+    RESULT="$(OMP_NUM_THREADS=$CORES "$TARGET_EXE" | grep '^Fin-' | tail -n 1)"
+    echo "  $ALGORITHM_NAME ${ARRAYS} arrays x ${CORES} cores: $RESULT"
+    if [[ -z "$REF" ]]; then
+      REF="$RESULT"
+    elif [[ "$RESULT" != "$REF" ]]; then
+      echo "  MISMATCH: expected '$REF'"
+      FAILED=1
+    fi
+  done
+done
+
+if (( FAILED )); then
+  echo "FAIL: results depend on the core count"; exit 1
+fi
+echo "PASS"
@@ -0,0 +1,171 @@
+// Copyright 2009-2025 NTESS.
+// This file is part of the SST software package.
+
+#ifndef _H_ANALOG_ARRAY_OPS
+#define _H_ANALOG_ARRAY_OPS
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace SST {
+namespace Golem {
+
+// Operations beyond the golem ComputeArray API. Array models that support
+// them inherit this next to ComputeArray; front-ends (RoCCAnalog,
+// SharedAnalogTile) discover it with dynamic_cast and reject the matching
+// instructions with rd=1 when it is missing.
+//
+// Buffers are passed type-erased, like ComputeArray::getOutputVector: they
+// hold the array's element type T.
+class AnalogArrayOps {
+public:
+    virtual ~AnalogArrayOps() = default;
+
+    // Reprogram rows [row0, row0+nrows) x cols [col0, col0+ncols) from a dense
+    // row-major block; the rest of the programmed matrix is left untouched
+    virtual void setMatrixRegion(uint32_t arrayID, uint32_t row0, uint32_t nrows,
+                                 uint32_t col0, uint32_t ncols, const void* data) = 0;
+
+    // Start y = A^T x on the programmed matrix. x is the first rows entries of
+    // the input buffer, y has cols entries; completion is reported through the
+    // array's handler exactly like beginComputation
+    virtual void beginTransposeComputation(uint32_t arrayID) = 0;
+
+    // Start Y = A X for k input vectors in one call. X holds k contiguous
+    // cols-long vectors; the k rows-long results are read back with
+    // getBatchOutput once the completion event arrives
+    virtual void beginBatchComputation(uint32_t arrayID, uint32_t k, const void* X) = 0;
+    virtual const void* getBatchOutput(uint32_t arrayID) = 0;
+
+    // Write the same len-entry input vector into every array selected by
+    // arrayMask (bit a = array a), as one operand fan-out
+    virtual void setVectorBlock(uint64_t arrayMask, uint32_t len, const void* x) = 0;
+
+    // Release the array's backing model and buffers (mvm.free). A later
+    // access rebuilds it with an all-zero matrix
+    virtual void freeArray(uint32_t arrayID) = 0;
+};
+
+// mvm.mm operand layout, latched by mvm.mm.cfg:
+//   rs1 = Y base address
+//   rs2 = k[15:0] | xStride[39:16] | yStride[63:40]   (strides in elements, 0 = dense)
+struct BatchConfig {
+    uint64_t yBase{0};
+    uint32_t k{0};
+    uint32_t xStride{0};
+    uint32_t yStride{0};
+
+    static BatchConfig decode(uint64_t rs1, uint64_t rs2) {
+        BatchConfig c;
+        c.yBase   = rs1;
+        c.k       = static_cast<uint32_t>(rs2 & 0xffff);
+        c.xStride = static_cast<uint32_t>((rs2 >> 16) & 0xffffff);
+        c.yStride = static_cast<uint32_t>((rs2 >> 40) & 0xffffff);
+        return c;
+    }
+};
+
+// Sub-matrix selected by mvm.set.rows / mvm.set.region, decoded from rs2:
+//   mvm.set.rows   rs2 = aid[15:0] | row0[31:16] | nrows[47:32]        (all columns)
+//   mvm.set.region rs2 = aid[15:0] | row0[27:16] | nrows[39:28]
+//                        | col0[51:40] | ncols[63:52]
+struct MatrixRegion {
+    uint32_t arrayID{0};
+    uint32_t row0{0};
+    uint32_t nrows{0};
+    uint32_t col0{0};
+    uint32_t ncols{0};
+
+    static MatrixRegion rows(uint64_t rs2, uint32_t cols) {
+        MatrixRegion r;
+        r.arrayID = static_cast<uint32_t>(rs2 & 0xffff);
+        r.row0    = static_cast<uint32_t>((rs2 >> 16) & 0xffff);
+        r.nrows   = static_cast<uint32_t>((rs2 >> 32) & 0xffff);
+        r.col0    = 0;
+        r.ncols   = cols;
+        return r;
+    }
+
+    static MatrixRegion region(uint64_t rs2) {
+        MatrixRegion r;
+        r.arrayID = static_cast<uint32_t>(rs2 & 0xffff);
+        r.row0    = static_cast<uint32_t>((rs2 >> 16) & 0xfff);
+        r.nrows   = static_cast<uint32_t>((rs2 >> 28) & 0xfff);
+        r.col0    = static_cast<uint32_t>((rs2 >> 40) & 0xfff);
+        r.ncols   = static_cast<uint32_t>((rs2 >> 52) & 0xfff);
+        return r;
+    }
+
+    // Re-encode in the mvm.set.region layout (used on the tile link)
+    uint64_t encode() const {
+        return  static_cast<uint64_t>(arrayID & 0xffff)
+             | (static_cast<uint64_t>(row0  & 0xfff) << 16)
+             | (static_cast<uint64_t>(nrows & 0xfff) << 28)
+             | (static_cast<uint64_t>(col0  & 0xfff) << 40)
+             | (static_cast<uint64_t>(ncols & 0xfff) << 52);
+    }
+
+    bool fits(uint32_t rows, uint32_t cols) const {
+        return nrows > 0 && ncols > 0 &&
+               static_cast<uint64_t>(row0) + nrows <= rows &&
+               static_cast<uint64_t>(col0) + ncols <= cols;
+    }
+
+    uint64_t cells() const { return static_cast<uint64_t>(nrows) * ncols; }
+};
+
+// Per-array conversion registers, loaded by mvm.cfg (rs1 = address of
+// {in_scale, in_offset, out_scale, out_offset} as binary32, 0 = reset;
+// rs2 = aid). While set, the vector operands of mvm.l, mvm.l.bcast, mvm.mm
+// and mvm.s are binary32 in memory whatever the array's element type, and
+// the front-end converts them:
+//   load   x_array = in_scale * x + in_offset     (rounded and saturated for integer T)
+//   store  y       = out_scale * y_array + out_offset
+// mvm.mv and mvm.mv.remote move array-format values untouched.
+struct ScaleConfig {
+    static constexpr uint32_t kBytes    = 16;
+    static constexpr uint32_t kElemSize = 4;
+
+    bool  enabled{false};
+    float inScale{1.0f};
+    float inOffset{0.0f};
+    float outScale{1.0f};
+    float outOffset{0.0f};
+
+    static ScaleConfig decode(const uint8_t* p) {
+        ScaleConfig c;
+        c.enabled = true;
+        std::memcpy(&c.inScale,   p + 0,  4);
+        std::memcpy(&c.inOffset,  p + 4,  4);
+        std::memcpy(&c.outScale,  p + 8,  4);
+        std::memcpy(&c.outOffset, p + 12, 4);
+        return c;
+    }
+
+    template <typename T>
+    T toArray(float x) const {
+        const double v = static_cast<double>(inScale) * x + inOffset;
+        if constexpr (std::is_integral<T>::value) {
+            const double lo = static_cast<double>(std::numeric_limits<T>::min());
+            const double hi = static_cast<double>(std::numeric_limits<T>::max());
+            if (!(v > lo)) return std::numeric_limits<T>::min();
+            if (!(v < hi)) return std::numeric_limits<T>::max();
+            return static_cast<T>(std::llround(v));
+        } else {
+            return static_cast<T>(v);
+        }
+    }
+
+    template <typename T>
+    float toMemory(T y) const {
+        return static_cast<float>(static_cast<double>(outScale) * static_cast<double>(y) + outOffset);
+    }
+};
+
+} // namespace Golem
+} // namespace SST
+
+#endif // _H_ANALOG_ARRAY_OPS
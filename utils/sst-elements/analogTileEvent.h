@@ -0,0 +1,56 @@
+// Copyright 2009-2025 NTESS.
+// This file is part of the SST software package.
+
+#ifndef _H_ANALOG_TILE_EVENT
+#define _H_ANALOG_TILE_EVENT
+
+#include <sst/core/event.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace SST {
+namespace Golem {
+
+// Operations a RoCC front-end can forward to a shared analog tile, plus the
+// peer-to-peer pair used by mvm.mv.remote
+enum class TileOp : uint8_t { SetMatrix, LoadVec, Compute, StoreVec, Move, RemoteVec, RemoteAck,
+                              SetRegion, ComputeT, MatMat, LoadBcast, Free };
+
+// Request/response between RoCCAnalog (front-end port) and SharedAnalogTile.
+// The tile answers on the same link, reusing the request event: `status` is
+// the RoCC rd value and, for StoreVec, `payload` carries the packed output.
+// RemoteVec/RemoteAck ride a Merlin VN between two RoCCAnalog instances; a
+// front-end on a shared tile passes a received RemoteVec on to its tile, with
+// the sender's nid in `arg`, and acks once the tile answers.
+class TileEvent : public SST::Event {
+public:
+    TileEvent() : SST::Event() {}
+    TileEvent(TileOp op, uint32_t arrayID)
+        : SST::Event(), op(op), arrayID(arrayID) {}
+
+    TileOp               op{TileOp::Compute};
+    uint32_t             arrayID{0};
+    uint32_t             aux{0};      // Move: destination array
+    uint64_t             arg{0};      // SetRegion: MatrixRegion::encode(); MatMat: k; LoadBcast: array mask;
+                                      // RemoteVec on a tile port: sender nid
+    uint64_t             status{0};
+    std::vector<uint8_t> payload;     // raw operand bytes (mvm.set / mvm.l* / mvm.s / mvm.mm)
+
+    void serialize_order(SST::Core::Serialization::serializer& ser) override {
+        Event::serialize_order(ser);
+        ser & op;
+        ser & arrayID;
+        ser & aux;
+        ser & arg;
+        ser & status;
+        ser & payload;
+    }
+
+    ImplementSerializable(SST::Golem::TileEvent);
+};
+
+} // namespace Golem
+} // namespace SST
+
+#endif // _H_ANALOG_TILE_EVENT
@@ -19,27 +19,68 @@
 #define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
 
 #include <sst/elements/golem/array/computeArray.h>
+#include "analogArrayOps.h"
+#include "crossSimPolicies.h"
 #include <Python.h>
 #include "numpy/arrayobject.h"
 #include <string>
 #include <type_traits>
 #include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <unistd.h>
 
 namespace SST {
 namespace Golem {
 
-template<typename T>
-class CrossSimComputeArray : public ComputeArray {
+// Threading, Storage and Log are the policies of crossSimPolicies.h. The
+// defaults defer each choice to a param, so one build covers every mode.
+template<typename T,
+         typename Threading = CROSSSIM_THREADING_POLICY,
+         typename Storage   = CROSSSIM_STORAGE_POLICY,
+         typename Log       = CROSSSIM_LOG_POLICY>
+class CrossSimComputeArray : public ComputeArray, public AnalogArrayOps {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT_DERIVED_API(
-        CrossSimComputeArray<T>,
+        CrossSimComputeArray,
         SST::Golem::ComputeArray,
         TimeConverter*,
         Event::HandlerBase*
     )
 
     SST_ELI_DOCUMENT_PARAMS(
-        {"CrossSimJSONParameters", "JSON configuration for CrossSim", "default"}
+        {"CrossSimJSONParameters", "JSON configuration for CrossSim", "default"},
+        {"cloneCores",         "Deep-copy a cached unprogrammed AnalogCore instead of constructing each one (copies share the prototype's RNG state)", "false"},
+        {"inputBits",          "Input precision driven per MVM (bit-serial DAC passes)", "8"},
+        {"mvmCellEnergy",      "pJ per cell per input bit during an MVM", "0"},
+        {"dacEnergy",          "pJ per column per input bit during an MVM", "0"},
+        {"adcEnergy",          "pJ per row (ADC conversion) per input bit during an MVM", "0"},
+        {"programCellEnergy",  "pJ per cell written by mvm.set", "0"},
+        {"bufferReadEnergy",   "pJ per byte read from the input/output buffers", "0"},
+        {"bufferWriteEnergy",  "pJ per byte written to the input/output buffers", "0"},
+        {"programCacheDir",    "Directory of pickled programmed AnalogCores, keyed by matrix/JSON/seed hash (empty = off)", ""},
+        {"programSeed",        "Seed full mvm.set programming noise from this and the matrix hash, leaving the global NumPy RNG as it was (-1 = unseeded)", "-1"},
+        {"fuseComputes",       "Gather forward MVMs completing at the same timestamp into one Python call", "false"},
+        {"pythonThreading",    "Interpreter discipline: inline (SST thread holds the GIL), gil (acquire per call), worker (one Python thread)", "inline"},
+        {"hostStaged",         "Stage mvm.set / mvm.l writes in host buffers, copied to NumPy before each Python call", "false"},
+        {"traceLog",           "Print a thread-tagged line for each materialize/program/compute/free", "false"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"energy_mvm",     "Energy spent in MVMs (pJ)", "pJ", 1},
+        {"energy_program", "Energy spent programming matrices (pJ)", "pJ", 1},
+        {"energy_buffer",  "Energy spent in input/output buffer accesses (pJ)", "pJ", 1},
+        {"nonzero_mvms",   "MVMs issued on tiles holding a nonzero matrix", "count", 1},
+        {"arrays_materialized", "AnalogCore instances built on first use of an array ID", "count", 1},
+        {"program_cache_hits",  "Full mvm.set calls served from programCacheDir", "count", 1},
+        {"program_cache_misses","Full mvm.set calls programmed by CrossSim with programCacheDir set", "count", 1},
+        {"fused_batch_size",    "Forward MVMs dispatched per fused Python call (fuseComputes)", "count", 2}
     )
 
     CrossSimComputeArray(ComponentId_t id, Params& params,
@@ -47,226 +88,278 @@ public:
                          Event::HandlerBase* handler)
         : ComputeArray(id, params, tc, handler)
     {
-        initializePython();
+        py.configure(params);
+        store.configure(params);
+        log.configure(params);
+        if (!CrossSim::PythonRuntime::acquire(py.mode())) {
+            out.fatal(CALL_INFO, -1, "pythonThreading=%s, but the interpreter was started as %s\n",
+                      CrossSim::threadingName(py.mode()),
+                      CrossSim::threadingName(CrossSim::PythonRuntime::mode()));
+        }
+        std::call_once(getNumpyFlag(), [this] { py.run([] { importNumpy(); }); });
+
         CrossSimJSON = params.find<std::string>("CrossSimJSONParameters");
+        cloneCores   = params.find<bool>("cloneCores", false);
+        programCacheDir = params.find<std::string>("programCacheDir", "");
+        programSeed     = params.find<int64_t>("programSeed", -1);
+        fuseComputes    = params.find<bool>("fuseComputes", false);
+
+        // Energy model (all pJ)
+        inputBits         = params.find<uint32_t>("inputBits", 8);
+        mvmCellEnergy     = params.find<double>("mvmCellEnergy", 0.0);
+        dacEnergy         = params.find<double>("dacEnergy", 0.0);
+        adcEnergy         = params.find<double>("adcEnergy", 0.0);
+        programCellEnergy = params.find<double>("programCellEnergy", 0.0);
+        bufferReadEnergy  = params.find<double>("bufferReadEnergy", 0.0);
+        bufferWriteEnergy = params.find<double>("bufferWriteEnergy", 0.0);
+
+        stat_energy_mvm     = registerStatistic<double>("energy_mvm");
+        stat_energy_program = registerStatistic<double>("energy_program");
+        stat_energy_buffer  = registerStatistic<double>("energy_buffer");
+        stat_nonzero_mvms   = registerStatistic<uint64_t>("nonzero_mvms");
+        stat_materialized   = registerStatistic<uint64_t>("arrays_materialized");
+        stat_cache_hits     = registerStatistic<uint64_t>("program_cache_hits");
+        stat_cache_misses   = registerStatistic<uint64_t>("program_cache_misses");
+        stat_fused_batch    = registerStatistic<uint64_t>("fused_batch_size");
 
         // Configure selfLink
         selfLink = configureSelfLink("Self", tc,
             new Event::Handler2<CrossSimComputeArray,&CrossSimComputeArray::handleSelfEvent>(this));
         selfLink->setDefaultTimeBase(latencyTC);
+        if (fuseComputes) {
+            // Zero-delay flush: runs after every compute already due at this timestamp
+            fuseLink = configureSelfLink("FuseFlush", tc,
+                new Event::Handler2<CrossSimComputeArray,&CrossSimComputeArray::handleFuseFlush>(this));
+        }
 
-        // Allocate arrays to hold Python objects
-        pyMatrix = new PyObject*[numArrays];
-        npMatrix = new PyArrayObject*[numArrays];
-        pyArrayIn = new PyObject*[numArrays];
-        npArrayIn = new PyArrayObject*[numArrays];
-        pyArrayOut = new PyObject*[numArrays];
-        npArrayOut = new PyArrayObject*[numArrays];
-        cores = new PyObject*[numArrays];
-        setMatrixFunction = new PyObject*[numArrays];
-        computeMVM = new PyObject*[numArrays];
-
-        // Initialize input/output vector storage
+        // Slots for Python objects; filled per array by materialize()
+        pyMatrix = new PyObject*[numArrays]();
+        npMatrix = new PyArrayObject*[numArrays]();
+        pyArrayIn = new PyObject*[numArrays]();
+        npArrayIn = new PyArrayObject*[numArrays]();
+        pyArrayInT = new PyObject*[numArrays]();
+        npArrayInT = new PyArrayObject*[numArrays]();
+        pyArrayOut = new PyObject*[numArrays]();
+        pyArrayOutT = new PyObject*[numArrays]();
+        npArrayOut = new PyArrayObject*[numArrays]();
+        mvmArgs = new PyObject*[numArrays]();
+        mvmArgsT = new PyObject*[numArrays]();
+        mvmOutKw = new PyObject*[numArrays]();
+        mvmOutKwT = new PyObject*[numArrays]();
+        cores = new PyObject*[numArrays]();
+        setMatrixFunction = new PyObject*[numArrays]();
+        computeMVM = new PyObject*[numArrays]();
+        computeMVMT = new PyObject*[numArrays]();
+        computeMatMat = new PyObject*[numArrays]();
+        pyBatchIn = new PyObject*[numArrays]();
+
+        // Host-side vectors are sized when an array is materialized
         inputVectors.resize(numArrays);
         outputVectors.resize(numArrays);
-        for (uint32_t i = 0; i < numArrays; i++) {
-            inputVectors[i].resize(inputArraySize, T());
-            outputVectors[i].resize(outputArraySize, T());
-        }
+        arrayNonzero.assign(numArrays, 0);
+        pendingTranspose.assign(numArrays, false);
+        pendingBatch.assign(numArrays, 0);
+        batchOutputs.resize(numArrays);
+        hostMatrix.resize(numArrays);
+        hostIn.resize(numArrays);
+        inDirty.assign(numArrays, false);
+        inflight.reset(new std::atomic<uint32_t>[numArrays]());
     }
 
     virtual ~CrossSimComputeArray() {
 
         // Decrement references to Python objects
-        for (uint32_t i = 0; i < numArrays; i++) {
-            Py_DECREF(pyMatrix[i]);
-            Py_DECREF(pyArrayIn[i]);
-            Py_DECREF(pyArrayOut[i]);
-            Py_DECREF(cores[i]);
-            Py_DECREF(setMatrixFunction[i]);
-            Py_DECREF(computeMVM[i]);
-        }
+        py.run([this] {
+            for (uint32_t i = 0; i < numArrays; i++) {
+                releaseArray(i);
+            }
+            Py_XDECREF(fusedCall);
+            Py_XDECREF(crossSim);
+            Py_XDECREF(paramsConstructor);
+            Py_XDECREF(AnalogCoreConstructor);
+            Py_XDECREF(crossSim_params);
+        });
 
         // Free our arrays
         delete[] pyMatrix;
         delete[] npMatrix;
         delete[] pyArrayIn;
         delete[] npArrayIn;
+        delete[] pyArrayInT;
+        delete[] npArrayInT;
         delete[] pyArrayOut;
+        delete[] pyArrayOutT;
         delete[] npArrayOut;
+        delete[] mvmArgs;
+        delete[] mvmArgsT;
+        delete[] mvmOutKw;
+        delete[] mvmOutKwT;
         delete[] cores;
         delete[] setMatrixFunction;
         delete[] computeMVM;
+        delete[] computeMVMT;
+        delete[] computeMatMat;
+        delete[] pyBatchIn;
 
-        // Decrement other references
-        Py_DECREF(crossSim);
-        Py_DECREF(paramsConstructor);
-        Py_DECREF(AnalogCoreConstructor);
-        Py_DECREF(crossSim_params);
         finalizePython();
     }
 
     virtual void init(unsigned int phase) override {
         if (phase == 0) {
-            uint64_t inputSize = inputArraySize;
-            uint64_t outputSize = outputArraySize;
-
-            // Prepare NumPy dimension info
-            int matrixNumDims = 2;
-            npy_intp matrixDims[2] = {
-                static_cast<npy_intp>(outputSize),
-                static_cast<npy_intp>(inputSize)
-            };
-
-            int arrayInNumDims = 1;
-            npy_intp arrayInDim[1] = { static_cast<npy_intp>(inputSize) };
-
-	    int arrayOutNumDims = 1;
-            npy_intp arrayOutDim[1] = { static_cast<npy_intp>(outputSize) };
-
-            int numpyType = getNumpyType();
-
-            // Create Numpy arrays
-            for (uint32_t i = 0; i < numArrays; i++) {
-                pyMatrix[i] = PyArray_SimpleNew(matrixNumDims, matrixDims, numpyType);
-                npMatrix[i] = reinterpret_cast<PyArrayObject*>(pyMatrix[i]);
-
-                pyArrayIn[i] = PyArray_SimpleNew(arrayInNumDims, arrayInDim, numpyType);
-                npArrayIn[i] = reinterpret_cast<PyArrayObject*>(pyArrayIn[i]);
-
-                pyArrayOut[i] = PyArray_SimpleNew(arrayOutNumDims, arrayOutDim, numpyType);
-                npArrayOut[i] = reinterpret_cast<PyArrayObject*>(pyArrayOut[i]);
-            }
-
-            // Import CrossSim (simulator.py) module
-            crossSim = PyImport_ImportModule("simulator");
-            if (!crossSim) {
-                out.fatal(CALL_INFO, -1, "Import CrossSim failed\n");
-                PyErr_Print();
-            }
+            py.run([this] { initCrossSim(); });
+        }
+    }
 
-            paramsConstructor = PyObject_GetAttrString(crossSim, "CrossSimParameters");
-            if (!paramsConstructor) {
-                out.fatal(CALL_INFO, -1, "Get CrossSimParameters constructor failed\n");
-                PyErr_Print();
-            }
+    virtual void beginComputation(uint32_t arrayID) override {
+        materialize(arrayID);
+        SimTime_t latency = getArrayLatency(arrayID);
+        ArrayEvent* ev = new ArrayEvent(arrayID);
+        selfLink->send(latency, ev);
+    }
 
-            AnalogCoreConstructor = PyObject_GetAttrString(crossSim, "AnalogCore");
-            if (!AnalogCoreConstructor) {
-                out.fatal(CALL_INFO, -1, "Get AnalogCore constructor failed\n");
-                PyErr_Print();
-            }
+    // A^T x on the same programmed conductances: completes like beginComputation
+    virtual void beginTransposeComputation(uint32_t arrayID) override {
+        materialize(arrayID);
+        pendingTranspose[arrayID] = true;
+        beginComputation(arrayID);
+    }
 
-            // Build the CrossSim parameters object
-            if (CrossSimJSON.empty()) {
-                crossSim_params = PyObject_CallFunction(paramsConstructor, NULL);
-            } else {
-                PyObject* fromJson = PyObject_GetAttrString(paramsConstructor, "from_json");
-                PyObject* jsonArgs = Py_BuildValue("(s)", CrossSimJSON.c_str());
-                crossSim_params = PyObject_CallObject(fromJson, jsonArgs);
-                Py_DECREF(fromJson);
-                Py_DECREF(jsonArgs);
-            }
-            if (!crossSim_params) {
-                out.fatal(CALL_INFO, -1, "Call to CrossSimParameters constructor failed\n");
-                PyErr_Print();
-            }
+    // k MVMs back to back on one array: one CrossSim matmat, k array latencies
+    virtual void beginBatchComputation(uint32_t arrayID, uint32_t k, const void* X) override {
+        materialize(arrayID);
+        const T* src = static_cast<const T*>(X);
 
-            // If the template type is uint64_t, then set params.core.output_dtype = "INT32"
-            if constexpr (std::is_same_v<T, int64_t>) {
-                // Get the "core" attribute from crossSim_params
-                PyObject* core = PyObject_GetAttrString(crossSim_params, "core");
-                if (!core) {
-                    out.fatal(CALL_INFO, -1, "Get core attribute from CrossSim parameters failed\n");
-                    PyErr_Print();
-                } else {
-                    // Set the output_dtype attribute of core to "INT32"
-                    PyObject* dtypeValue = PyUnicode_FromString("INT64");
-                    if (PyObject_SetAttrString(core, "output_dtype", dtypeValue) != 0) {
-                        out.fatal(CALL_INFO, -1, "Failed to set output_dtype on core\n");
-                        PyErr_Print();
-                    }
-                    Py_DECREF(dtypeValue);
-                    Py_DECREF(core);
-                }
-            }
-	    
-            // Create the cores
-            for (uint32_t i = 0; i < numArrays; i++) {
-                cores[i] = PyObject_CallFunctionObjArgs(AnalogCoreConstructor,
-                                                        pyMatrix[i],
-                                                        crossSim_params,
-                                                        NULL);
-                if (!cores[i]) {
-                    out.fatal(CALL_INFO, -1, "Call to AnalogCore failed\n");
-                    PyErr_Print();
-                }
-                setMatrixFunction[i] = PyObject_GetAttrString(cores[i], "set_matrix");
-                if (!setMatrixFunction[i]) {
-                    out.fatal(CALL_INFO, -1, "Get core.set_matrix failed\n");
-                    PyErr_Print();
-                }
-                computeMVM[i] = PyObject_GetAttrString(cores[i], "matvec");
-                if (!computeMVM[i]) {
-                    out.fatal(CALL_INFO, -1, "Get core.matvec failed\n");
-                    PyErr_Print();
+        // AnalogCore.matmat takes the k vectors as columns of a (cols x k) matrix
+        py.run([&] {
+            npy_intp dims[2] = { static_cast<npy_intp>(inputArraySize), static_cast<npy_intp>(k) };
+            Py_XDECREF(pyBatchIn[arrayID]);
+            pyBatchIn[arrayID] = PyArray_SimpleNew(2, dims, getNumpyType());
+            T* data = reinterpret_cast<T*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(pyBatchIn[arrayID])));
+            for (uint32_t j = 0; j < k; j++) {
+                for (uint32_t c = 0; c < inputArraySize; c++) {
+                    data[c * k + j] = src[j * inputArraySize + c];
                 }
             }
+        });
+        stat_energy_buffer->addData(bufferWriteEnergy * k * inputArraySize * sizeof(T));
 
-        }
+        pendingBatch[arrayID] = k;
+        selfLink->send(k * getArrayLatency(arrayID), new ArrayEvent(arrayID));
     }
 
-    virtual void beginComputation(uint32_t arrayID) override {
-        SimTime_t latency = getArrayLatency(arrayID);
-        ArrayEvent* ev = new ArrayEvent(arrayID);
-        selfLink->send(latency, ev);
+    virtual const void* getBatchOutput(uint32_t arrayID) override {
+        stat_energy_buffer->addData(bufferReadEnergy * batchOutputs[arrayID].size() * sizeof(T));
+        return static_cast<const void*>(batchOutputs[arrayID].data());
     }
 
     virtual void handleSelfEvent(Event* ev) override {
         ArrayEvent* aev = static_cast<ArrayEvent*>(ev);
         uint32_t arrayID = aev->getArrayID();
 
-        compute(arrayID);
+        if (pendingBatch[arrayID]) {
+            const uint32_t k = pendingBatch[arrayID];
+            pendingBatch[arrayID] = 0;
+            py.run([&] { computeBatch(arrayID, k); });
+        } else if (pendingTranspose[arrayID]) {
+            pendingTranspose[arrayID] = false;
+            py.run([&] { computeTranspose(arrayID); });
+        } else if (fuseLink) {
+            if (fusedPending.empty()) fuseLink->send(0, new ArrayEvent(arrayID));
+            fusedPending.push_back(aev);
+            return; // completed by handleFuseFlush
+        } else {
+            py.run([&] { compute(arrayID); });
+        }
         (*tileHandler)(ev);
     }
 
+    // All forward MVMs due at this timestamp run in one Python call, then
+    // complete in arrival order
+    void handleFuseFlush(Event* ev) {
+        delete ev;
+        std::vector<ArrayEvent*> batch;
+        batch.swap(fusedPending);
+        py.run([&] { computeFused(batch); });
+        for (ArrayEvent* aev : batch) (*tileHandler)(aev);
+    }
+
     virtual void setMatrixItem(int32_t arrayID, int32_t index, double value) override {
-        T* data = reinterpret_cast<T*>(PyArray_DATA(npMatrix[arrayID]));
+        materialize(arrayID);
+        T* data = store.staged() ? hostMatrix[arrayID].data()
+                                 : reinterpret_cast<T*>(PyArray_DATA(npMatrix[arrayID]));
         data[index] = static_cast<T>(value);
 
-        // Once matrix is fully populated, call "set_matrix"
+        // Once matrix is fully populated, call "set_matrix". Nothing waits on
+        // it: the next touch of this array fences, and the next Python section
+        // is ordered after it.
         if (index == inputArraySize * outputArraySize - 1) {
-            PyObject* status = PyObject_CallFunctionObjArgs(setMatrixFunction[arrayID],
-                                                            npMatrix[arrayID],
-                                                            NULL);
-            if (!status) {
-                out.fatal(CALL_INFO, -1, "Call to core.set_matrix failed\n");
-                PyErr_Print();
-            }
+            // Statistics and the nonzero flag stay on this thread
+            const size_t cells = static_cast<size_t>(inputArraySize) * outputArraySize;
+            arrayNonzero[arrayID] = std::any_of(data, data + cells, [](T v) { return v != T(); });
+            stat_energy_program->addData(programCellEnergy * cells);
+            inflight[arrayID].fetch_add(1, std::memory_order_relaxed);
+            py.post(&CrossSimComputeArray::programThunk, this, arrayID);
         }
     }
 
+    // Partial reprogramming: write the block into our host copy, then hand
+    // CrossSim only the changed slice (AnalogCore.__setitem__)
+    virtual void setMatrixRegion(uint32_t arrayID, uint32_t row0, uint32_t nrows,
+                                 uint32_t col0, uint32_t ncols, const void* block) override {
+        materialize(arrayID);
+        py.run([&] { programRegion(arrayID, row0, nrows, col0, ncols, static_cast<const T*>(block)); });
+    }
+
+    // One input buffer of max(rows, cols) entries; npArrayIn/npArrayInT are
+    // its forward (cols) and transposed (rows) views
     virtual void setVectorItem(int32_t arrayID, int32_t index, double value) override {
-        T* data = reinterpret_cast<T*>(PyArray_DATA(npArrayIn[arrayID]));
-        data[index] = static_cast<T>(value);
+        materialize(arrayID);
+        if (store.staged()) {
+            if (index < static_cast<int32_t>(hostIn[arrayID].size())) {
+                hostIn[arrayID][index] = static_cast<T>(value);
+                inDirty[arrayID] = true;
+            }
+        } else {
+            if (index < static_cast<int32_t>(inputArraySize)) {
+                reinterpret_cast<T*>(PyArray_DATA(npArrayIn[arrayID]))[index] = static_cast<T>(value);
+            }
+            if (index < static_cast<int32_t>(outputArraySize)) {
+                reinterpret_cast<T*>(PyArray_DATA(npArrayInT[arrayID]))[index] = static_cast<T>(value);
+            }
+        }
+        stat_energy_buffer->addData(bufferWriteEnergy * sizeof(T));
     }
 
-    virtual void compute(uint32_t arrayID) override {
-        // Perform the MVM
-        pyArrayOut[arrayID] = PyObject_CallFunctionObjArgs(computeMVM[arrayID],
-                                                           npArrayIn[arrayID],
-                                                           NULL);
-        if (!pyArrayOut[arrayID]) {
-            out.fatal(CALL_INFO, -1, "Run MVM Call Failed\n");
-            PyErr_Print();
+    // mvm.l.bcast: one operand, written to both views of each selected buffer
+    virtual void setVectorBlock(uint64_t arrayMask, uint32_t len, const void* x) override {
+        const T* src = static_cast<const T*>(x);
+        for (uint32_t a = 0; a < numArrays && a < 64; a++) {
+            if (!((arrayMask >> a) & 1)) continue;
+            materialize(a);
+            if (store.staged()) {
+                std::copy(src, src + std::min<uint64_t>(len, hostIn[a].size()), hostIn[a].begin());
+                inDirty[a] = true;
+                stat_energy_buffer->addData(bufferWriteEnergy * len * sizeof(T));
+                continue;
+            }
+            std::copy(src, src + std::min<uint64_t>(len, inputArraySize),
+                      reinterpret_cast<T*>(PyArray_DATA(npArrayIn[a])));
+            std::copy(src, src + std::min<uint64_t>(len, outputArraySize),
+                      reinterpret_cast<T*>(PyArray_DATA(npArrayInT[a])));
+            stat_energy_buffer->addData(bufferWriteEnergy * len * sizeof(T));
         }
-        npArrayOut[arrayID] = reinterpret_cast<PyArrayObject*>(pyArrayOut[arrayID]);
+    }
+
+    virtual void compute(uint32_t arrayID) override {
+        fence(arrayID);
+        syncInput(arrayID);
+        accountMVM(arrayID);
+        log.trace("array %u mvm", arrayID);
 
-        // Copy output for later retrieval
-        int len = PyArray_SIZE(npArrayOut[arrayID]);
-        outputVectors[arrayID].resize(len);
-        T* outputData = reinterpret_cast<T*>(PyArray_DATA(npArrayOut[arrayID]));
-        std::copy(outputData, outputData + len, outputVectors[arrayID].begin());
+        // Perform the MVM straight into outputVectors
+        runMVM(arrayID, computeMVM[arrayID], mvmArgs[arrayID], mvmOutKw[arrayID],
+               pyArrayOut[arrayID], outputArraySize);
+        const T* outputData = outputVectors[arrayID].data();
 
         // Optional debug printing
         out.verbose(CALL_INFO, 2, 0, "CrossSim MVM on array %u:\n", arrayID);
@@ -291,31 +384,151 @@ public:
         out.verbose(CALL_INFO, 2, 0, "\n\n");
     }
 
+    void computeFused(const std::vector<ArrayEvent*>& batch) {
+        if (batch.size() == 1) { compute(batch[0]->getArrayID()); return; }
+        stat_fused_batch->addData(batch.size());
+
+        PyObject* fns  = PyList_New(batch.size());
+        PyObject* xs   = PyList_New(batch.size());
+        PyObject* outs = PyList_New(batch.size());
+        for (size_t n = 0; n < batch.size(); n++) {
+            const uint32_t a = batch[n]->getArrayID();
+            fence(a);
+            syncInput(a);
+            accountMVM(a);
+            outputVectors[a].resize(outputArraySize);
+            Py_INCREF(computeMVM[a]); PyList_SET_ITEM(fns,  n, computeMVM[a]);
+            Py_INCREF(pyArrayIn[a]);  PyList_SET_ITEM(xs,   n, pyArrayIn[a]);
+            Py_INCREF(pyArrayOut[a]); PyList_SET_ITEM(outs, n, pyArrayOut[a]);
+        }
+
+        PyObject* results = PyObject_CallFunction(fusedCall, "OOOO", fns, xs, outs,
+                                                  matvecOut ? Py_True : Py_False);
+        if (!results) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Fused MVM Call Failed\n");
+        }
+
+        // Every result already sits in outputVectors behind pyArrayOut
+        for (size_t n = 0; n < batch.size(); n++) {
+            const uint32_t a = batch[n]->getArrayID();
+            npArrayOut[a] = reinterpret_cast<PyArrayObject*>(pyArrayOut[a]);
+        }
+        Py_DECREF(results);
+        Py_DECREF(outs);
+        Py_DECREF(xs);
+        Py_DECREF(fns);
+
+        log.trace("fused mvm over %zu arrays", batch.size());
+        out.verbose(CALL_INFO, 2, 0, "CrossSim fused MVM over %zu arrays\n", batch.size());
+    }
+
+    void computeTranspose(uint32_t arrayID) {
+        fence(arrayID);
+        syncInput(arrayID);
+        accountMVM(arrayID, true);
+        log.trace("array %u mvm.t", arrayID);
+
+        // y = x^T A  (== A^T x), x has outputSize entries, y has inputSize
+        runMVM(arrayID, computeMVMT[arrayID], mvmArgsT[arrayID], mvmOutKwT[arrayID],
+               pyArrayOutT[arrayID], inputArraySize);
+
+        out.verbose(CALL_INFO, 2, 0, "CrossSim transposed MVM on array %u (%u outputs)\n",
+                    arrayID, static_cast<uint32_t>(inputArraySize));
+    }
+
+    void computeBatch(uint32_t arrayID, uint32_t k) {
+        fence(arrayID);
+        for (uint32_t j = 0; j < k; j++) accountMVM(arrayID);
+
+        PyObject* result = PyObject_CallFunctionObjArgs(computeMatMat[arrayID],
+                                                        pyBatchIn[arrayID],
+                                                        NULL);
+        if (!result) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Run MatMat Call Failed\n");
+        }
+
+        // (rows x k) -> k contiguous output vectors
+        PyArrayObject* npResult = reinterpret_cast<PyArrayObject*>(
+            PyArray_FROM_OTF(result, getNumpyType(), NPY_ARRAY_IN_ARRAY));
+        const T* data = reinterpret_cast<const T*>(PyArray_DATA(npResult));
+        auto& outs = batchOutputs[arrayID];
+        outs.resize(static_cast<size_t>(k) * outputArraySize);
+        for (uint32_t j = 0; j < k; j++) {
+            for (uint32_t r = 0; r < outputArraySize; r++) {
+                outs[j * outputArraySize + r] = data[r * k + j];
+            }
+        }
+        Py_DECREF(npResult);
+        Py_DECREF(result);
+
+        // The output buffer keeps the last vector, as if k mvm's had run
+        outputVectors[arrayID].assign(outs.end() - outputArraySize, outs.end());
+        npArrayOut[arrayID] = reinterpret_cast<PyArrayObject*>(pyArrayOut[arrayID]);
+
+        out.verbose(CALL_INFO, 2, 0, "CrossSim MatMat on array %u (k=%u)\n", arrayID, k);
+    }
+
+    // mvm.free: drop the AnalogCore and buffers; the next use starts from a zero matrix
+    virtual void freeArray(uint32_t arrayID) override {
+        fence(arrayID);
+        if (!cores[arrayID]) return;
+        py.run([&] { releaseArray(arrayID); });
+        log.trace("array %u freed", arrayID);
+        out.verbose(CALL_INFO, 2, 0, "CrossSim array %u released\n", arrayID);
+    }
+
     virtual SimTime_t getArrayLatency(uint32_t arrayID) override {
         return 1;
     }
 
     virtual void moveOutputToInput(uint32_t srcArrayID, uint32_t destArrayID) override {
+        materialize(srcArrayID);
+        materialize(destArrayID);
+        // Output length follows the last MVM direction (rows forward, cols transposed)
         T* src = reinterpret_cast<T*>(PyArray_DATA(npArrayOut[srcArrayID]));
-        T* dst = reinterpret_cast<T*>(PyArray_DATA(npArrayIn[destArrayID]));
-        std::copy(src, src + outputArraySize, dst);
+        const npy_intp len = PyArray_SIZE(npArrayOut[srcArrayID]);
+        if (store.staged()) {
+            std::copy(src, src + std::min<npy_intp>(len, hostIn[destArrayID].size()),
+                      hostIn[destArrayID].begin());
+            inDirty[destArrayID] = true;
+        } else {
+            T* dst  = reinterpret_cast<T*>(PyArray_DATA(npArrayIn[destArrayID]));
+            T* dstT = reinterpret_cast<T*>(PyArray_DATA(npArrayInT[destArrayID]));
+            std::copy(src, src + std::min<npy_intp>(len, inputArraySize), dst);
+            std::copy(src, src + std::min<npy_intp>(len, outputArraySize), dstT);
+        }
+        stat_energy_buffer->addData((bufferReadEnergy + bufferWriteEnergy) * len * sizeof(T));
     }
 
     virtual void* getInputVector(uint32_t arrayID) override {
+        materialize(arrayID);
         // Convert NumPy array data to std::vector (if needed)
-        T* data = reinterpret_cast<T*>(PyArray_DATA(npArrayIn[arrayID]));
-        int len = PyArray_SIZE(npArrayIn[arrayID]);
+        const T* data = store.staged() ? hostIn[arrayID].data()
+                                       : reinterpret_cast<T*>(PyArray_DATA(npArrayIn[arrayID]));
+        const int len = inputArraySize;
         inputVectors[arrayID].resize(len);
         std::copy(data, data + len, inputVectors[arrayID].begin());
         return static_cast<void*>(&inputVectors[arrayID]);
     }
 
     virtual void* getOutputVector(uint32_t arrayID) override {
+        materialize(arrayID);
+        // Rows after a forward MVM, columns after mvm.t
+        stat_energy_buffer->addData(bufferReadEnergy * outputVectors[arrayID].size() * sizeof(T));
         return static_cast<void*>(&outputVectors[arrayID]);
     }
 
 protected:
+    Threading py;
+    Storage   store;
+    Log       log;
+
     std::string CrossSimJSON;
+    bool        cloneCores = false;
+    std::string programCacheDir;
+    int64_t     programSeed = -1;
 
     // Python object references
     PyObject* crossSim            = nullptr;
@@ -328,16 +541,486 @@ protected:
     PyArrayObject** npMatrix     = nullptr;
     PyObject** pyArrayIn         = nullptr;
     PyArrayObject** npArrayIn    = nullptr;
-    PyObject** pyArrayOut        = nullptr;
-    PyArrayObject** npArrayOut   = nullptr;
+    PyObject** pyArrayOut        = nullptr;   // views pinned on outputVectors (rows)
+    PyObject** pyArrayOutT       = nullptr;   // ... and (cols) for mvm.t
+    PyArrayObject** npArrayOut   = nullptr;   // whichever view holds the last result
+    PyObject** mvmArgs           = nullptr;   // (in,) / (inT,) / {"out": view}, built once
+    PyObject** mvmArgsT          = nullptr;
+    PyObject** mvmOutKw          = nullptr;
+    PyObject** mvmOutKwT         = nullptr;
+    bool       matvecOut         = false;     // matvec/vecmat take out= (set by bindCore)
+
+    // fuseComputes
+    bool                     fuseComputes = false;
+    SST::Link*               fuseLink     = nullptr;
+    PyObject*                fusedCall    = nullptr;
+    std::vector<ArrayEvent*> fusedPending;
     PyObject** cores             = nullptr;
     PyObject** setMatrixFunction = nullptr;
     PyObject** computeMVM        = nullptr;
+    PyObject** pyArrayInT        = nullptr;
+    PyArrayObject** npArrayInT   = nullptr;
+    PyObject** computeMVMT       = nullptr;
+    std::vector<bool> pendingTranspose;
+    PyObject** computeMatMat     = nullptr;
+    PyObject** pyBatchIn         = nullptr;
+    std::vector<uint32_t> pendingBatch;
+    std::vector<std::vector<T>> batchOutputs;
 
     // Local copy of input/output
     std::vector<std::vector<T>> inputVectors;
     std::vector<std::vector<T>> outputVectors;
 
+    // hostStaged: matrix and input writes land here, outside interpreter memory
+    std::vector<std::vector<T>> hostMatrix;
+    std::vector<std::vector<T>> hostIn;      // max(rows, cols), both views
+    std::vector<bool>           inDirty;
+
+    // Posted Python sections still running against each array
+    std::unique_ptr<std::atomic<uint32_t>[]> inflight;
+
+    // Energy model
+    uint32_t inputBits         = 8;
+    double   mvmCellEnergy     = 0.0;
+    double   dacEnergy         = 0.0;
+    double   adcEnergy         = 0.0;
+    double   programCellEnergy = 0.0;
+    double   bufferReadEnergy  = 0.0;
+    double   bufferWriteEnergy = 0.0;
+    std::vector<uint8_t> arrayNonzero;   // one byte per array (no shared bit words)
+
+    Statistic<double>*   stat_energy_mvm     = nullptr;
+    Statistic<double>*   stat_energy_program = nullptr;
+    Statistic<double>*   stat_energy_buffer  = nullptr;
+    Statistic<uint64_t>* stat_nonzero_mvms   = nullptr;
+    Statistic<uint64_t>* stat_materialized   = nullptr;
+    Statistic<uint64_t>* stat_cache_hits     = nullptr;
+    Statistic<uint64_t>* stat_cache_misses   = nullptr;
+    Statistic<uint64_t>* stat_fused_batch    = nullptr;
+
+    // Import CrossSim (simulator.py) and fetch its constructors
+    void initCrossSim() {
+        // Import CrossSim (simulator.py) module
+        crossSim = PyImport_ImportModule("simulator");
+        if (!crossSim) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Import CrossSim failed\n");
+        }
+
+        paramsConstructor = PyObject_GetAttrString(crossSim, "CrossSimParameters");
+        if (!paramsConstructor) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Get CrossSimParameters constructor failed\n");
+        }
+
+        AnalogCoreConstructor = PyObject_GetAttrString(crossSim, "AnalogCore");
+        if (!AnalogCoreConstructor) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Get AnalogCore constructor failed\n");
+        }
+
+        // Parsed once per process for each distinct JSON (and element type)
+        ParamEntry& entry = acquireParams();
+        crossSim_params = entry.params;
+        Py_INCREF(crossSim_params);
+        if (cloneCores) corePrototype = &entry;
+
+        if (fuseComputes) buildFusedCall();
+
+        // AnalogCores are built per array on first use (materialize)
+    }
+
+    // Python-side loop for fuseComputes: one interpreter entry for the whole batch.
+    // Results land in the outs views, through out= or np.copyto; CrossSim v3.0
+    // matvec has no out=, so it still allocates its own result per MVM.
+    void buildFusedCall() {
+        static const char* src =
+            "import numpy as np\n"
+            "def golem_fused_matvec(fns, xs, outs, use_out):\n"
+            "    for f, x, o in zip(fns, xs, outs):\n"
+            "        if use_out:\n"
+            "            f(x, out=o)\n"
+            "        else:\n"
+            "            np.copyto(o, f(x))\n";
+        PyObject* globals = PyDict_New();
+        PyDict_SetItemString(globals, "__builtins__", PyEval_GetBuiltins());
+        PyObject* r = PyRun_String(src, Py_file_input, globals, globals);
+        fusedCall = r ? PyDict_GetItemString(globals, "golem_fused_matvec") : nullptr;
+        if (!fusedCall) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Building fused MVM helper failed\n");
+        }
+        Py_INCREF(fusedCall);
+        Py_XDECREF(r);
+        Py_DECREF(globals);
+    }
+
+    // Build array `i` (NumPy buffers + AnalogCore) the first time it is touched
+    void materialize(uint32_t i) {
+        fence(i);
+        if (cores[i]) return;
+        py.run([&] { buildArray(i); });
+        log.trace("array %u materialized", i);
+    }
+
+    void buildArray(uint32_t i) {
+        npy_intp matrixDims[2] = { static_cast<npy_intp>(outputArraySize),
+                                   static_cast<npy_intp>(inputArraySize) };
+        npy_intp arrayInDim[1]  = { static_cast<npy_intp>(inputArraySize) };
+        npy_intp arrayOutDim[1] = { static_cast<npy_intp>(outputArraySize) };
+        const int numpyType = getNumpyType();
+
+        pyMatrix[i] = PyArray_ZEROS(2, matrixDims, numpyType, 0);
+        npMatrix[i] = reinterpret_cast<PyArrayObject*>(pyMatrix[i]);
+
+        pyArrayIn[i] = PyArray_ZEROS(1, arrayInDim, numpyType, 0);
+        npArrayIn[i] = reinterpret_cast<PyArrayObject*>(pyArrayIn[i]);
+
+        // Transposed MVM drives the rows: its input is outputSize long
+        pyArrayInT[i] = PyArray_ZEROS(1, arrayOutDim, numpyType, 0);
+        npArrayInT[i] = reinterpret_cast<PyArrayObject*>(pyArrayInT[i]);
+
+        // Results are written in place: the output views alias outputVectors[i],
+        // whose capacity never changes while the array is live
+        npy_intp arrayOutDimT[1] = { static_cast<npy_intp>(inputArraySize) };
+        outputVectors[i].reserve(std::max<uint64_t>(inputArraySize, outputArraySize));
+        outputVectors[i].assign(outputArraySize, T());
+        pyArrayOut[i]  = PyArray_SimpleNewFromData(1, arrayOutDim, numpyType, outputVectors[i].data());
+        pyArrayOutT[i] = PyArray_SimpleNewFromData(1, arrayOutDimT, numpyType, outputVectors[i].data());
+        npArrayOut[i]  = reinterpret_cast<PyArrayObject*>(pyArrayOut[i]);
+
+        mvmArgs[i]   = PyTuple_Pack(1, pyArrayIn[i]);
+        mvmArgsT[i]  = PyTuple_Pack(1, pyArrayInT[i]);
+        mvmOutKw[i]  = Py_BuildValue("{s:O}", "out", pyArrayOut[i]);
+        mvmOutKwT[i] = Py_BuildValue("{s:O}", "out", pyArrayOutT[i]);
+
+        cores[i] = corePrototype ? cloneCore() : nullptr;
+        if (!cores[i]) {
+            cores[i] = PyObject_CallFunctionObjArgs(AnalogCoreConstructor,
+                                                    pyMatrix[i],
+                                                    crossSim_params,
+                                                    NULL);
+        }
+        if (!cores[i]) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Call to AnalogCore failed\n");
+        }
+        bindCore(i);
+
+        inputVectors[i].assign(inputArraySize, T());
+        if (store.staged()) {
+            hostMatrix[i].assign(static_cast<size_t>(inputArraySize) * outputArraySize, T());
+            hostIn[i].assign(std::max<uint64_t>(inputArraySize, outputArraySize), T());
+            inDirty[i] = false;
+        }
+        arrayNonzero[i] = 0;
+        stat_materialized->addData(1);
+    }
+
+    // Wait out posted sections (programMatrix) before the SST thread touches array i
+    void fence(uint32_t i) {
+        for (unsigned n = 0; inflight[i].load(std::memory_order_acquire); ) {
+            CrossSim::PythonWorker::backoff(n);
+        }
+    }
+
+    static void programThunk(void* self, uint64_t arrayID) {
+        auto* a = static_cast<CrossSimComputeArray*>(self);
+        a->programMatrix(static_cast<uint32_t>(arrayID));
+        a->inflight[arrayID].fetch_sub(1, std::memory_order_release);
+    }
+
+    // hostStaged: publish pending input writes to both NumPy views
+    void syncInput(uint32_t i) {
+        if (!store.staged() || !inDirty[i]) return;
+        const T* src = hostIn[i].data();
+        std::copy(src, src + inputArraySize,  reinterpret_cast<T*>(PyArray_DATA(npArrayIn[i])));
+        std::copy(src, src + outputArraySize, reinterpret_cast<T*>(PyArray_DATA(npArrayInT[i])));
+        inDirty[i] = false;
+    }
+
+    // Full mvm.set: hand the populated matrix to CrossSim (or the program cache).
+    // May run on the worker, so it touches no statistics or shared flags.
+    void programMatrix(uint32_t arrayID) {
+        T* data = reinterpret_cast<T*>(PyArray_DATA(npMatrix[arrayID]));
+        const size_t cells = static_cast<size_t>(inputArraySize) * outputArraySize;
+        if (store.staged()) std::copy(hostMatrix[arrayID].begin(), hostMatrix[arrayID].end(), data);
+
+        const uint64_t key = programKey(data, cells);
+        if (programCacheDir.empty() || !loadProgrammed(arrayID, key)) {
+            PyObject* saved = programSeed >= 0 ? swapNumpyState(key) : nullptr;
+            PyObject* status = PyObject_CallFunctionObjArgs(setMatrixFunction[arrayID],
+                                                            npMatrix[arrayID],
+                                                            NULL);
+            if (!status) PyErr_Print();
+            restoreNumpyState(saved);
+            if (!status) out.fatal(CALL_INFO, -1, "Call to core.set_matrix failed\n");
+            Py_XDECREF(status);
+            if (!programCacheDir.empty()) storeProgrammed(arrayID, key);
+        }
+        log.trace("array %u programmed", arrayID);
+    }
+
+    // Partial reprogramming: write the block into our host copy, then hand
+    // CrossSim only the changed slice (AnalogCore.__setitem__)
+    void programRegion(uint32_t arrayID, uint32_t row0, uint32_t nrows,
+                       uint32_t col0, uint32_t ncols, const T* src) {
+        T* data = reinterpret_cast<T*>(PyArray_DATA(npMatrix[arrayID]));
+        for (uint32_t r = 0; r < nrows; r++) {
+            std::copy(src + r * ncols, src + (r + 1) * ncols,
+                      data + (row0 + r) * inputArraySize + col0);
+            if (store.staged()) {
+                std::copy(src + r * ncols, src + (r + 1) * ncols,
+                          hostMatrix[arrayID].begin() + (row0 + r) * inputArraySize + col0);
+            }
+        }
+
+        npy_intp blockDims[2] = { static_cast<npy_intp>(nrows), static_cast<npy_intp>(ncols) };
+        PyObject* pyBlock = PyArray_SimpleNew(2, blockDims, getNumpyType());
+        std::copy(src, src + static_cast<size_t>(nrows) * ncols,
+                  reinterpret_cast<T*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(pyBlock))));
+
+        PyObject* rows = makeSlice(row0, row0 + nrows);
+        PyObject* cols = makeSlice(col0, col0 + ncols);
+        PyObject* key  = PyTuple_Pack(2, rows, cols);
+        if (PyObject_SetItem(cores[arrayID], key, pyBlock) != 0) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Call to core.__setitem__ failed\n");
+        }
+        Py_DECREF(key);
+        Py_DECREF(cols);
+        Py_DECREF(rows);
+        Py_DECREF(pyBlock);
+
+        const size_t cells = static_cast<size_t>(inputArraySize) * outputArraySize;
+        arrayNonzero[arrayID] = std::any_of(data, data + cells, [](T v) { return v != T(); });
+        stat_energy_program->addData(programCellEnergy * nrows * ncols);
+        log.trace("array %u region %ux%u programmed", arrayID, nrows, ncols);
+    }
+
+    // One MVM on prebuilt args, landing in outputVectors[i] through `view`.
+    // Uses out= when bindCore found it; otherwise copies the returned array.
+    void runMVM(uint32_t i, PyObject* method, PyObject* args, PyObject* outKw,
+                PyObject* view, uint32_t len) {
+        outputVectors[i].resize(len); // within reserved capacity: view stays valid
+
+        PyObject* result = PyObject_Call(method, args, matvecOut ? outKw : NULL);
+        if (!result) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Run MVM Call Failed\n");
+        }
+
+        if (result != view) {
+            PyArrayObject* r = reinterpret_cast<PyArrayObject*>(result);
+            const T* data = reinterpret_cast<const T*>(PyArray_DATA(r));
+            std::copy(data, data + std::min<npy_intp>(PyArray_SIZE(r), len), outputVectors[i].begin());
+        }
+        Py_DECREF(result);
+        npArrayOut[i] = reinterpret_cast<PyArrayObject*>(view);
+    }
+
+    // True if `method`'s signature names an out parameter
+    static bool acceptsOut(PyObject* method) {
+        PyObject* inspect = PyImport_ImportModule("inspect");
+        PyObject* sig     = inspect ? PyObject_CallMethod(inspect, "signature", "O", method) : nullptr;
+        PyObject* params  = sig ? PyObject_GetAttrString(sig, "parameters") : nullptr;
+        PyObject* name    = PyUnicode_FromString("out");
+        const int has     = params ? PySequence_Contains(params, name) : -1;
+        if (has < 0) PyErr_Clear();
+        Py_XDECREF(name);
+        Py_XDECREF(params);
+        Py_XDECREF(sig);
+        Py_XDECREF(inspect);
+        return has == 1;
+    }
+
+    // Cache the bound methods of cores[i]
+    void bindCore(uint32_t i) {
+        Py_XDECREF(setMatrixFunction[i]);
+        Py_XDECREF(computeMVM[i]);
+        Py_XDECREF(computeMVMT[i]);
+        Py_XDECREF(computeMatMat[i]);
+        setMatrixFunction[i] = PyObject_GetAttrString(cores[i], "set_matrix");
+        if (!setMatrixFunction[i]) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Get core.set_matrix failed\n");
+        }
+        computeMVM[i] = PyObject_GetAttrString(cores[i], "matvec");
+        if (!computeMVM[i]) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Get core.matvec failed\n");
+        }
+        computeMVMT[i] = PyObject_GetAttrString(cores[i], "vecmat");
+        if (!computeMVMT[i]) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Get core.vecmat failed\n");
+        }
+        computeMatMat[i] = PyObject_GetAttrString(cores[i], "matmat");
+        if (!computeMatMat[i]) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Get core.matmat failed\n");
+        }
+
+        // Decided here, once, so no MVM is ever issued twice
+        matvecOut = acceptsOut(computeMVM[i]) && acceptsOut(computeMVMT[i]);
+        if (!matvecOut) {
+            out.verbose(CALL_INFO, 1, 0, "AnalogCore has no out= argument, copying results\n");
+        }
+    }
+
+    // ---- Programmed-state cache (programCacheDir) ----
+
+    // FNV-1a over the matrix, shape, element type, JSON and seed
+    uint64_t programKey(const T* data, size_t cells) const {
+        uint64_t h = 1469598103934665603ULL;
+        auto mix = [&h](const void* p, size_t n) {
+            const uint8_t* b = static_cast<const uint8_t*>(p);
+            for (size_t k = 0; k < n; k++) { h ^= b[k]; h *= 1099511628211ULL; }
+        };
+        const uint64_t shape[3] = { outputArraySize, inputArraySize, sizeof(T) };
+        mix(shape, sizeof(shape));
+        mix(data, cells * sizeof(T));
+        mix(CrossSimJSON.data(), CrossSimJSON.size());
+        mix(&programSeed, sizeof(programSeed));
+        return h;
+    }
+
+    std::string programPath(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "/%016llx.pkl", static_cast<unsigned long long>(key));
+        return programCacheDir + name;
+    }
+
+    // Deterministic programming noise: the same matrix and seed program the same way.
+    // CrossSim draws from the global numpy.random, so set_matrix runs with the
+    // state of a local MT19937 seeded from the full key and the caller's global
+    // state is put back afterwards; read noise and other arrays never see it.
+    PyObject* swapNumpyState(uint64_t key) {
+        PyObject* random = PyImport_ImportModule("numpy.random");
+        PyObject* saved  = random ? PyObject_CallMethod(random, "get_state", NULL) : nullptr;
+        PyObject* seq    = saved ? PyObject_CallMethod(random, "SeedSequence", "([KK])",
+                                       static_cast<unsigned long long>(key),
+                                       static_cast<unsigned long long>(programSeed)) : nullptr;
+        PyObject* bitgen = seq ? PyObject_CallMethod(random, "MT19937", "O", seq) : nullptr;
+        PyObject* local  = bitgen ? PyObject_CallMethod(random, "RandomState", "O", bitgen) : nullptr;
+        PyObject* state  = local ? PyObject_CallMethod(local, "get_state", NULL) : nullptr;
+        PyObject* r      = state ? PyObject_CallMethod(random, "set_state", "O", state) : nullptr;
+        if (!r) {
+            PyErr_Clear();
+            out.verbose(CALL_INFO, 1, 0, "numpy.random state swap failed, programming unseeded\n");
+            Py_CLEAR(saved);
+        }
+        Py_XDECREF(r);
+        Py_XDECREF(state);
+        Py_XDECREF(local);
+        Py_XDECREF(bitgen);
+        Py_XDECREF(seq);
+        Py_XDECREF(random);
+        return saved;
+    }
+
+    void restoreNumpyState(PyObject* saved) {
+        if (!saved) return;
+        PyObject* random = PyImport_ImportModule("numpy.random");
+        PyObject* r = random ? PyObject_CallMethod(random, "set_state", "O", saved) : nullptr;
+        if (!r) PyErr_Clear();
+        Py_XDECREF(r);
+        Py_XDECREF(random);
+        Py_DECREF(saved);
+    }
+
+    // Replace cores[i] with a pickled, already-programmed core
+    bool loadProgrammed(uint32_t i, uint64_t key) {
+        std::ifstream f(programPath(key), std::ios::binary);
+        if (!f) { stat_cache_misses->addData(1); return false; }
+        std::stringstream buf;
+        buf << f.rdbuf();
+        const std::string bytes = buf.str();
+
+        PyObject* pickle = PyImport_ImportModule("pickle");
+        PyObject* blob   = PyBytes_FromStringAndSize(bytes.data(), bytes.size());
+        PyObject* core   = pickle ? PyObject_CallMethod(pickle, "loads", "O", blob) : nullptr;
+        Py_XDECREF(blob);
+        Py_XDECREF(pickle);
+        if (!core) {
+            PyErr_Clear();
+            out.verbose(CALL_INFO, 1, 0, "Program cache entry %s unreadable, reprogramming\n",
+                        programPath(key).c_str());
+            stat_cache_misses->addData(1);
+            return false;
+        }
+        Py_DECREF(cores[i]);
+        cores[i] = core;
+        bindCore(i);
+        stat_cache_hits->addData(1);
+        return true;
+    }
+
+    // Write-then-rename so concurrent sweep points never see a partial file
+    void storeProgrammed(uint32_t i, uint64_t key) {
+        PyObject* pickle = PyImport_ImportModule("pickle");
+        PyObject* blob   = pickle ? PyObject_CallMethod(pickle, "dumps", "O", cores[i]) : nullptr;
+        Py_XDECREF(pickle);
+        if (!blob) {
+            PyErr_Clear();
+            out.verbose(CALL_INFO, 1, 0, "AnalogCore not picklable, disabling program cache\n");
+            programCacheDir.clear();
+            return;
+        }
+        const std::string path = programPath(key);
+        const std::string tmp  = path + "." + std::to_string(::getpid()) + "." + std::to_string(i) + ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary);
+            f.write(PyBytes_AS_STRING(blob), PyBytes_GET_SIZE(blob));
+        }
+        Py_DECREF(blob);
+        if (std::rename(tmp.c_str(), path.c_str()) != 0) std::remove(tmp.c_str());
+    }
+
+    void releaseArray(uint32_t i) {
+        Py_CLEAR(pyMatrix[i]);
+        Py_CLEAR(pyArrayIn[i]);
+        Py_CLEAR(pyArrayInT[i]);
+        Py_CLEAR(mvmArgs[i]);
+        Py_CLEAR(mvmArgsT[i]);
+        Py_CLEAR(mvmOutKw[i]);
+        Py_CLEAR(mvmOutKwT[i]);
+        Py_CLEAR(pyArrayOut[i]);
+        Py_CLEAR(pyArrayOutT[i]);
+        Py_CLEAR(cores[i]);
+        Py_CLEAR(setMatrixFunction[i]);
+        Py_CLEAR(computeMVM[i]);
+        Py_CLEAR(computeMVMT[i]);
+        Py_CLEAR(computeMatMat[i]);
+        Py_CLEAR(pyBatchIn[i]);
+        npMatrix[i] = npArrayIn[i] = npArrayInT[i] = npArrayOut[i] = nullptr;
+
+        std::vector<T>().swap(inputVectors[i]);
+        std::vector<T>().swap(outputVectors[i]);
+        std::vector<T>().swap(batchOutputs[i]);
+        std::vector<T>().swap(hostMatrix[i]);
+        std::vector<T>().swap(hostIn[i]);
+        inDirty[i]          = false;
+        arrayNonzero[i]     = 0;
+        pendingTranspose[i] = false;
+        pendingBatch[i]     = 0;
+    }
+
+    // Bit-serial MVM: every input bit drives the DACs and fires the ADCs once.
+    // An all-zero tile is skipped by the controller, so only its periphery is charged.
+    // Transposed MVMs drive the rows and sense the columns.
+    void accountMVM(uint32_t arrayID, bool transposed = false) {
+        const double rows = transposed ? inputArraySize  : outputArraySize;
+        const double cols = transposed ? outputArraySize : inputArraySize;
+        double pJ = inputBits * (cols * dacEnergy + rows * adcEnergy);
+        if (arrayNonzero[arrayID]) {
+            pJ += inputBits * rows * cols * mvmCellEnergy;
+            stat_nonzero_mvms->addData(1);
+        }
+        stat_energy_mvm->addData(pJ);
+        stat_energy_buffer->addData(bufferReadEnergy * cols * sizeof(T));
+    }
+
     int getNumpyType() {
         if constexpr (std::is_same<T, int64_t>::value) {
             return NPY_INT64;
@@ -349,6 +1032,15 @@ protected:
         }
     }
 
+    static PyObject* makeSlice(uint32_t lo, uint32_t hi) {
+        PyObject* start = PyLong_FromUnsignedLong(lo);
+        PyObject* stop  = PyLong_FromUnsignedLong(hi);
+        PyObject* slice = PySlice_New(start, stop, NULL);
+        Py_DECREF(start);
+        Py_DECREF(stop);
+        return slice;
+    }
+
     void printValue(const T& value) {
         if constexpr (std::is_same<T, int64_t>::value) {
             out.verbose(CALL_INFO, 2, 0, "%ld ", value);
@@ -359,35 +1051,132 @@ protected:
 
 private:
 
-    static std::atomic<int>& getInstanceCount() {
-        static std::atomic<int> count{0};
-        return count;
+    // Process-wide CrossSimParameters cache, keyed by the JSON text plus element
+    // type. `prototype` is an unprogrammed AnalogCore for cloneCores, built on
+    // first request for a given array shape.
+    struct ParamEntry {
+        PyObject* params    = nullptr;
+        PyObject* prototype = nullptr;
+        uint64_t  protoRows = 0;
+        uint64_t  protoCols = 0;
+    };
+
+    ParamEntry* corePrototype = nullptr;
+
+    static std::unordered_map<std::string, ParamEntry>& getParamCache() {
+        static std::unordered_map<std::string, ParamEntry> cache;
+        return cache;
+    }
+
+    static std::mutex& getParamCacheMutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    ParamEntry& acquireParams() {
+        std::lock_guard<std::mutex> lock(getParamCacheMutex());
+        PyGILState_STATE gil = PyGILState_Ensure();
+
+        const std::string key = CrossSimJSON + (std::is_same_v<T, int64_t> ? "#INT64" : "#FLOAT32");
+        ParamEntry& entry = getParamCache()[key];
+        if (!entry.params) {
+            entry.params = buildParams();
+        }
+
+        PyGILState_Release(gil);
+        return entry;
+    }
+
+    PyObject* buildParams() {
+        PyObject* params = nullptr;
+        if (CrossSimJSON.empty()) {
+            params = PyObject_CallFunction(paramsConstructor, NULL);
+        } else {
+            PyObject* fromJson = PyObject_GetAttrString(paramsConstructor, "from_json");
+            PyObject* jsonArgs = Py_BuildValue("(s)", CrossSimJSON.c_str());
+            params = PyObject_CallObject(fromJson, jsonArgs);
+            Py_DECREF(fromJson);
+            Py_DECREF(jsonArgs);
+        }
+        if (!params) {
+            PyErr_Print();
+            out.fatal(CALL_INFO, -1, "Call to CrossSimParameters constructor failed\n");
+        }
+
+        // If the template type is int64_t, then set params.core.output_dtype = "INT64"
+        if constexpr (std::is_same_v<T, int64_t>) {
+            PyObject* core = PyObject_GetAttrString(params, "core");
+            if (!core) {
+                PyErr_Print();
+                out.fatal(CALL_INFO, -1, "Get core attribute from CrossSim parameters failed\n");
+            } else {
+                PyObject* dtypeValue = PyUnicode_FromString("INT64");
+                if (PyObject_SetAttrString(core, "output_dtype", dtypeValue) != 0) {
+                    PyErr_Print();
+                    out.fatal(CALL_INFO, -1, "Failed to set output_dtype on core\n");
+                }
+                Py_DECREF(dtypeValue);
+                Py_DECREF(core);
+            }
+        }
+        return params;
+    }
+
+    // copy.deepcopy of the cached prototype; nullptr means construct normally
+    PyObject* cloneCore() {
+        std::lock_guard<std::mutex> lock(getParamCacheMutex());
+        PyGILState_STATE gil = PyGILState_Ensure();
+
+        ParamEntry& e = *corePrototype;
+        if (e.prototype && (e.protoRows != outputArraySize || e.protoCols != inputArraySize)) {
+            PyGILState_Release(gil);
+            return nullptr; // cached for another shape
+        }
+        if (!e.prototype) {
+            npy_intp dims[2] = { static_cast<npy_intp>(outputArraySize),
+                                 static_cast<npy_intp>(inputArraySize) };
+            PyObject* zeros = PyArray_ZEROS(2, dims, getNumpyType(), 0);
+            e.prototype = PyObject_CallFunctionObjArgs(AnalogCoreConstructor, zeros, e.params, NULL);
+            Py_DECREF(zeros);
+            e.protoRows = outputArraySize;
+            e.protoCols = inputArraySize;
+        }
+
+        PyObject* copy = nullptr;
+        PyObject* copyModule = PyImport_ImportModule("copy");
+        if (e.prototype && copyModule) {
+            copy = PyObject_CallMethod(copyModule, "deepcopy", "O", e.prototype);
+        }
+        Py_XDECREF(copyModule);
+        if (!copy) {
+            PyErr_Clear();
+            out.verbose(CALL_INFO, 1, 0, "AnalogCore deepcopy unavailable, constructing\n");
+        }
+
+        PyGILState_Release(gil);
+        return copy;
     }
 
-    static std::once_flag& getInitFlag() {
+    // NumPy's C-API table is per translation unit, so it is imported here
+    // rather than in CrossSim::PythonRuntime
+    static std::once_flag& getNumpyFlag() {
         static std::once_flag flag;
         return flag;
     }
 
-    // This function is called only once, by the first instance constructed.
-    static void doPythonInitialization() {
-        Py_Initialize();
+    static void importNumpy() {
         import_array1();  // NumPy C-API init
     }
 
-    // Called in the constructor.
-    void initializePython() {
-        std::call_once(getInitFlag(), doPythonInitialization);
-        // Increase instance count.
-        ++getInstanceCount();
-    }
-
-    // Called in the destructor.
+    // Called in the destructor; the last instance finalizes the interpreter
     void finalizePython() {
-        // Decrease instance count.
-        if (--getInstanceCount() == 0) {
-            Py_Finalize();
-        }
+        CrossSim::PythonRuntime::release([] {
+            for (auto& kv : getParamCache()) {
+                Py_XDECREF(kv.second.prototype);
+                Py_XDECREF(kv.second.params);
+            }
+            getParamCache().clear();
+        });
     }
 
 };
@@ -0,0 +1,384 @@
+// Copyright 2009-2025 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2025, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _CROSSSIMPOLICIES_H
+#define _CROSSSIMPOLICIES_H
+
+#include <sst/core/params.h>
+#include <sst/core/output.h>
+#include <Python.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace SST {
+namespace Golem {
+namespace CrossSim {
+
+// How CrossSimComputeArray enters the interpreter:
+//   Inline  the SST thread keeps the GIL for the whole run (one SST thread only)
+//   GIL     every Python section takes/releases the GIL (several SST threads)
+//   Worker  all Python runs on one process-wide worker thread
+enum class Threading { Inline, GIL, Worker };
+
+inline const char* threadingName(Threading m) {
+    switch (m) {
+        case Threading::Inline: return "inline";
+        case Threading::GIL:    return "gil";
+        default:                return "worker";
+    }
+}
+
+inline bool parseThreading(const std::string& s, Threading& m) {
+    if (s == "inline") { m = Threading::Inline; return true; }
+    if (s == "gil")    { m = Threading::GIL;    return true; }
+    if (s == "worker") { m = Threading::Worker; return true; }
+    return false;
+}
+
+// ---------------- Dedicated interpreter thread (Threading::Worker) ----------------
+// Commands are PODs in a bounded lock-free MPSC ring (one slot sequence number
+// per entry). post() is fire-and-forget; call() waits on a flag in the
+// caller's frame. The worker drains every ready command under one GIL hold.
+class PythonWorker {
+public:
+    typedef void (*Fn)(void* ctx, uint64_t arg);
+
+    static PythonWorker& get() {
+        static PythonWorker w;
+        return w;
+    }
+
+    // Queue fn(ctx, arg) and return; ctx must outlive the command
+    void post(Fn fn, void* ctx, uint64_t arg) {
+        if (onWorker()) { fn(ctx, arg); return; }
+        start();
+        push(Command{ fn, ctx, arg, nullptr });
+    }
+
+    // Run f on the worker and wait for it; calls made from the worker itself
+    // (nested sections) run in place. Earlier posts complete first.
+    template <typename F> void call(F& f) {
+        if (onWorker()) { f(); return; }
+        start();
+        std::atomic<bool> done{false};
+        push(Command{ [](void* p, uint64_t) { (*static_cast<F*>(p))(); },
+                      const_cast<void*>(static_cast<const void*>(&f)), 0, &done });
+        for (unsigned n = 0; !done.load(std::memory_order_acquire); ) backoff(n);
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(startMtx);
+        if (!running.load(std::memory_order_relaxed)) return;
+        running.store(false, std::memory_order_release);
+        if (thread.joinable()) thread.join();
+    }
+
+    static void backoff(unsigned& n) {
+        if (++n < 64) std::this_thread::yield();
+        else std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+
+private:
+    struct Command {
+        Fn                 fn;
+        void*              ctx;
+        uint64_t           arg;
+        std::atomic<bool>* done;   // null for post()
+    };
+
+    struct Slot {
+        std::atomic<size_t> seq;
+        Command             cmd;
+    };
+
+    static constexpr size_t kRing = 4096;   // power of two
+
+    PythonWorker() {
+        for (size_t i = 0; i < kRing; i++) ring[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    static bool& onWorker() {
+        static thread_local bool flag = false;
+        return flag;
+    }
+
+    void start() {
+        if (running.load(std::memory_order_acquire)) return;
+        std::lock_guard<std::mutex> lock(startMtx);
+        if (running.load(std::memory_order_relaxed)) return;
+        running.store(true, std::memory_order_release);
+        thread = std::thread([this] { loop(); });
+    }
+
+    void push(const Command& c) {
+        size_t pos = head.load(std::memory_order_relaxed);
+        Slot*  slot;
+        for (unsigned n = 0;;) {
+            slot = &ring[pos & (kRing - 1)];
+            const intptr_t dif = static_cast<intptr_t>(slot->seq.load(std::memory_order_acquire)) -
+                                 static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (dif < 0) {
+                backoff(n);   // ring full: wait for the worker
+                pos = head.load(std::memory_order_relaxed);
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->cmd = c;
+        slot->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    // Single consumer
+    bool pop(Command& c) {
+        Slot& slot = ring[tail & (kRing - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != tail + 1) return false;
+        c = slot.cmd;
+        slot.seq.store(tail + kRing, std::memory_order_release);
+        ++tail;
+        return true;
+    }
+
+    void loop() {
+        onWorker() = true;
+        Command c;
+        for (unsigned idle = 0;;) {
+            if (!pop(c)) {
+                if (!running.load(std::memory_order_acquire)) break;
+                backoff(idle);
+                continue;
+            }
+            idle = 0;
+            PyGILState_STATE g = PyGILState_Ensure();
+            do {
+                c.fn(c.ctx, c.arg);
+                if (c.done) c.done->store(true, std::memory_order_release);
+            } while (pop(c));
+            PyGILState_Release(g);
+        }
+    }
+
+    Slot                ring[kRing];
+    std::atomic<size_t> head{0};
+    size_t              tail{0};
+    std::atomic<bool>   running{false};
+    std::mutex          startMtx;
+    std::thread         thread;
+};
+
+// ---------------- Process-wide interpreter lifetime ----------------
+// The first array instance initializes CPython for its threading mode; every
+// later instance must ask for the same one. The last one finalizes.
+class PythonRuntime {
+public:
+    static bool acquire(Threading m) {
+        std::lock_guard<std::mutex> lock(mtx());
+        State& s = state();
+        if (s.users++ == 0 && !s.initialized) {
+            s.mode = m;
+            Py_Initialize();
+            s.initialized = true;
+            // GIL and Worker modes enter through PyGILState_Ensure
+            if (m != Threading::Inline) s.mainThread = PyEval_SaveThread();
+        }
+        return s.mode == m;
+    }
+
+    // beforeFinalize runs with the GIL held, right before Py_Finalize
+    static void release(const std::function<void()>& beforeFinalize) {
+        std::lock_guard<std::mutex> lock(mtx());
+        State& s = state();
+        if (--s.users > 0) return;
+        if (s.mode == Threading::Worker) PythonWorker::get().stop();
+        if (s.mainThread) {
+            PyEval_RestoreThread(s.mainThread);
+            s.mainThread = nullptr;
+        }
+        beforeFinalize();
+        Py_Finalize();
+    }
+
+    static Threading mode() { return state().mode; }
+
+private:
+    struct State {
+        int            users{0};
+        bool           initialized{false};
+        Threading      mode{Threading::Inline};
+        PyThreadState* mainThread{nullptr};
+    };
+    static State& state() { static State s; return s; }
+    static std::mutex& mtx() { static std::mutex m; return m; }
+};
+
+// ---------------- Threading policies ----------------
+// run(f) executes a Python section under the policy's interpreter discipline.
+// Sections may nest. post(fn, ctx, arg) is a section whose completion the
+// caller does not wait for; only the worker policy actually defers it.
+
+struct InlineThreading {
+    void      configure(Params&) {}
+    Threading mode() const { return Threading::Inline; }
+    template <typename F> void run(F&& f) { f(); }
+    void post(PythonWorker::Fn fn, void* ctx, uint64_t arg) { fn(ctx, arg); }
+};
+
+struct GILThreading {
+    void      configure(Params&) {}
+    Threading mode() const { return Threading::GIL; }
+    template <typename F> void run(F&& f) {
+        PyGILState_STATE g = PyGILState_Ensure();
+        f();
+        PyGILState_Release(g);
+    }
+    void post(PythonWorker::Fn fn, void* ctx, uint64_t arg) {
+        PyGILState_STATE g = PyGILState_Ensure();
+        fn(ctx, arg);
+        PyGILState_Release(g);
+    }
+};
+
+struct WorkerThreading {
+    void      configure(Params&) {}
+    Threading mode() const { return Threading::Worker; }
+    template <typename F> void run(F&& f) { PythonWorker::get().call(f); }
+    void post(PythonWorker::Fn fn, void* ctx, uint64_t arg) { PythonWorker::get().post(fn, ctx, arg); }
+};
+
+// Picked from the "pythonThreading" param (inline | gil | worker)
+struct RuntimeThreading {
+    void configure(Params& params) {
+        const std::string s = params.find<std::string>("pythonThreading", "inline");
+        if (!parseThreading(s, m)) {
+            Output::getDefaultObject().fatal(CALL_INFO, -1,
+                "CrossSim: unknown pythonThreading '%s' (inline | gil | worker)\n", s.c_str());
+        }
+    }
+    Threading mode() const { return m; }
+    template <typename F> void run(F&& f) {
+        switch (m) {
+            case Threading::Inline: inl.run(std::forward<F>(f)); break;
+            case Threading::GIL:    gil.run(std::forward<F>(f)); break;
+            default:                wrk.run(std::forward<F>(f)); break;
+        }
+    }
+    void post(PythonWorker::Fn fn, void* ctx, uint64_t arg) {
+        switch (m) {
+            case Threading::Inline: inl.post(fn, ctx, arg); break;
+            case Threading::GIL:    gil.post(fn, ctx, arg); break;
+            default:                wrk.post(fn, ctx, arg); break;
+        }
+    }
+
+private:
+    Threading       m{Threading::Inline};
+    InlineThreading inl;
+    GILThreading    gil;
+    WorkerThreading wrk;
+};
+
+// ---------------- Storage policies ----------------
+// NumPy-direct: mvm.set / mvm.l write straight into the NumPy buffers.
+// Host-staged: writes land in host vectors and are copied into NumPy inside
+// the next Python section, so element writes never touch interpreter memory.
+
+struct NumpyDirectStorage {
+    void configure(Params&) {}
+    bool staged() const { return false; }
+};
+
+struct HostStagedStorage {
+    void configure(Params&) {}
+    bool staged() const { return true; }
+};
+
+// Picked from the "hostStaged" param
+struct RuntimeStorage {
+    void configure(Params& params) { hostStaged = params.find<bool>("hostStaged", false); }
+    bool staged() const { return hostStaged; }
+
+private:
+    bool hostStaged{false};
+};
+
+// ---------------- Logging policies ----------------
+// trace() marks Python-side events (materialize, program, compute, free)
+
+struct QuietLog {
+    void configure(Params&) {}
+    void trace(const char*, ...) {}
+};
+
+// Thread-tagged lines on stdout, serialized across instances
+struct TraceLog {
+    void configure(Params&) {}
+    void trace(const char* fmt, ...) {
+        va_list ap;
+        va_start(ap, fmt);
+        emit(fmt, ap);
+        va_end(ap);
+    }
+
+    static void emit(const char* fmt, va_list ap) {
+        static std::mutex m;
+        char buf[512];
+        std::vsnprintf(buf, sizeof(buf), fmt, ap);
+        std::lock_guard<std::mutex> lock(m);
+        std::printf("[CrossSim] thread %zu %s\n",
+                    std::hash<std::thread::id>{}(std::this_thread::get_id()), buf);
+        std::fflush(stdout);
+    }
+};
+
+// Enabled by the "traceLog" param
+struct RuntimeLog {
+    void configure(Params& params) { enabled = params.find<bool>("traceLog", false); }
+    void trace(const char* fmt, ...) {
+        if (!enabled) return;
+        va_list ap;
+        va_start(ap, fmt);
+        TraceLog::emit(fmt, ap);
+        va_end(ap);
+    }
+
+private:
+    bool enabled{false};
+};
+
+} // namespace CrossSim
+} // namespace Golem
+} // namespace SST
+
+// Compile-time defaults; the Runtime* policies defer the choice to params
+#ifndef CROSSSIM_THREADING_POLICY
+#define CROSSSIM_THREADING_POLICY SST::Golem::CrossSim::RuntimeThreading
+#endif
+#ifndef CROSSSIM_STORAGE_POLICY
+#define CROSSSIM_STORAGE_POLICY SST::Golem::CrossSim::RuntimeStorage
+#endif
+#ifndef CROSSSIM_LOG_POLICY
+#define CROSSSIM_LOG_POLICY SST::Golem::CrossSim::RuntimeLog
+#endif
+
+#endif /* _CROSSSIMPOLICIES_H */
@@ -7,16 +7,21 @@
 #include <sst/core/output.h>
 #include <sst/core/subcomponent.h>
 #include <sst/core/interfaces/stdMem.h>
+#include <sst/core/interfaces/simpleNetwork.h>
 
 #include <sst/elements/vanadis/rocc/vroccinterface.h>
 #include <sst/elements/golem/array/computeArray.h>
 
+#include "analogTileEvent.h"
+#include "analogArrayOps.h"
+
 #include <cinttypes>
 #include <cstdint>
 #include <cstring>
 #include <deque>
 #include <vector>
 #include <algorithm>
+#include <string>
 #include <type_traits>
 
 using namespace SST::Interfaces;
@@ -31,6 +36,28 @@ class RoCCAnalog : public SST::Vanadis::VanadisRoCCInterface {
 public:
     SST_ELI_REGISTER_SUBCOMPONENT_DERIVED_API(RoCCAnalog<T>, SST::Vanadis::VanadisRoCCInterface)
 
+    SST_ELI_DOCUMENT_PORTS(
+        {"tile", "Optional link to a SharedAnalogTile; replaces the private array", {"SST::Golem::TileEvent"}}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"energy_mem", "Energy moving operands between the RoCC and the cache hierarchy (pJ)", "pJ", 1},
+        {"energy_net", "Energy moving vectors over the network for mvm.mv.remote (pJ)", "pJ", 1},
+        {"op_count",        "Completed commands, subId = op (set/load/store/compute/move/remote/region/compute_t/mm/cfg/bcast/free/scale)", "count", 1},
+        {"busy_cycles",     "Cycles with a command in flight", "cycles", 1},
+        {"idle_cycles",     "Cycles with no command in flight", "cycles", 1},
+        {"stall_cycles",    "Busy cycles by what the op waits on, subId = memory/array/network", "cycles", 2},
+        {"bytes_read",      "Bytes read from memory, subId = op", "bytes", 2},
+        {"bytes_written",   "Bytes written to memory (store) or the network (remote), subId = op", "bytes", 2},
+        {"op_latency",      "Push-to-completion latency, subId = op; enable as a histogram", "cycles", 3},
+        {"array_busy_cycles", "Cycles each array spends computing, subId = arrayN", "cycles", 3},
+        {"queue_occupancy", "roccQ depth sampled every cycle", "entries", 4}
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"network_interface", "Optional Merlin endpoint for mvm.mv.remote", "SST::Interfaces::SimpleNetwork"}
+    )
+
     RoCCAnalog(ComponentId_t id, Params& params)
     : VanadisRoCCInterface(id, params),
       max_instructions(params.find<size_t>("max_instructions", 8))
@@ -52,6 +79,38 @@ public:
         arrayOutputSize   = params.find<uint32_t>("arrayOutputSize", 2);
         inputOperandSize  = params.find<uint32_t>("inputOperandSize", 4);
         outputOperandSize = params.find<uint32_t>("outputOperandSize", 4);
+        scaleRegs.assign(numArrays, ScaleConfig{});
+
+        // Data-movement energy (pJ/byte)
+        memEnergy = params.find<double>("memEnergy", 0.0);
+        netEnergy = params.find<double>("netEnergy", 0.0);
+        stat_energy_mem = registerStatistic<double>("energy_mem");
+        stat_energy_net = registerStatistic<double>("energy_net");
+
+        // Activity / stall breakdown
+        for (size_t op = 1; op < kNumOps; ++op) {
+            stat_op_count[op]   = registerStatistic<uint64_t>("op_count",   kOpNames[op]);
+            stat_op_latency[op] = registerStatistic<uint64_t>("op_latency", kOpNames[op]);
+        }
+        stat_bytes_read[opIdx(CurOp::SetMatrix)]     = registerStatistic<uint64_t>("bytes_read",    "set");
+        stat_bytes_read[opIdx(CurOp::LoadVec)]       = registerStatistic<uint64_t>("bytes_read",    "load");
+        stat_bytes_read[opIdx(CurOp::SetRegion)]     = registerStatistic<uint64_t>("bytes_read",    "region");
+        stat_bytes_read[opIdx(CurOp::MatMat)]        = registerStatistic<uint64_t>("bytes_read",    "mm");
+        stat_bytes_read[opIdx(CurOp::LoadBcast)]     = registerStatistic<uint64_t>("bytes_read",    "bcast");
+        stat_bytes_read[opIdx(CurOp::ScaleCfg)]      = registerStatistic<uint64_t>("bytes_read",    "scale");
+        stat_bytes_written[opIdx(CurOp::MatMat)]     = registerStatistic<uint64_t>("bytes_written", "mm");
+        stat_bytes_written[opIdx(CurOp::StoreVec)]   = registerStatistic<uint64_t>("bytes_written", "store");
+        stat_bytes_written[opIdx(CurOp::RemoteMove)] = registerStatistic<uint64_t>("bytes_written", "remote");
+        stat_busy_cycles     = registerStatistic<uint64_t>("busy_cycles");
+        stat_idle_cycles     = registerStatistic<uint64_t>("idle_cycles");
+        stat_stall_memory    = registerStatistic<uint64_t>("stall_cycles", "memory");
+        stat_stall_array     = registerStatistic<uint64_t>("stall_cycles", "array");
+        stat_stall_network   = registerStatistic<uint64_t>("stall_cycles", "network");
+        stat_queue_occupancy = registerStatistic<uint64_t>("queue_occupancy");
+        for (uint32_t a = 0; a < numArrays; ++a) {
+            stat_array_busy.push_back(
+                registerStatistic<uint64_t>("array_busy_cycles", "array" + std::to_string(a)));
+        }
 
         // Memory interface: deliver all mem responses to processIncomingRequest(...)
         memIF = loadUserSubComponent<SST::Interfaces::StandardMem>(
@@ -66,29 +125,67 @@ public:
             output->fatal(CALL_INFO, -1, "%s failed to load memory_interface\n", getName().c_str());
         }
 
-        // Array model: completion comes via handleArrayEvent(...)
-        array = loadUserSubComponent<SST::Golem::ComputeArray>(
-            "array",
-            ComponentInfo::SHARE_NONE,
-            getTimeConverter("1ps"),
+        // Remote moves: output vectors travel to peer coprocessors on their own VN
+        remoteVN         = params.find<int>("remote_vn", 2);
+        remoteNidBase    = params.find<uint64_t>("remote_nid_base", 0);
+        remoteHeaderBits = params.find<uint32_t>("remote_header_bits", 64);
+        nic = loadUserSubComponent<SST::Interfaces::SimpleNetwork>(
+            "network_interface", ComponentInfo::SHARE_NONE, remoteVN + 1);
+        if (nic) {
+            nic->setNotifyOnReceive(
+                new SST::Interfaces::SimpleNetwork::Handler2<
+                    RoCCAnalog<T>,
+                    &RoCCAnalog<T>::handleNetEvent>(this));
+            netSendHandler = new SST::Interfaces::SimpleNetwork::Handler2<
+                RoCCAnalog<T>,
+                &RoCCAnalog<T>::drainNetQueue>(this);
+        }
+
+        // Shared tile: array ops are forwarded, completion via handleTileEvent(...)
+        tileLink = configureLink("tile",
             new SST::Event::Handler2<
                 RoCCAnalog<T>,
-                &RoCCAnalog<T>::handleArrayEvent>(this)
-        );
-        if (!array) {
-            output->fatal(CALL_INFO, -1, "%s failed to load array subcomponent\n", getName().c_str());
+                &RoCCAnalog<T>::handleTileEvent>(this));
+
+        // Private array model: completion comes via handleArrayEvent(...)
+        if (!tileLink) {
+            array = loadUserSubComponent<SST::Golem::ComputeArray>(
+                "array",
+                ComponentInfo::SHARE_NONE,
+                getTimeConverter("1ps"),
+                new SST::Event::Handler2<
+                    RoCCAnalog<T>,
+                    &RoCCAnalog<T>::handleArrayEvent>(this)
+            );
+            if (!array) {
+                output->fatal(CALL_INFO, -1, "%s failed to load array subcomponent\n", getName().c_str());
+            }
+            arrayOps = dynamic_cast<AnalogArrayOps*>(array);
         }
 
+        // Programming cost: mvm.set* retire rows*rowProgramLatency after the data lands
+        rowProgramPs = (params.find<UnitAlgebra>("rowProgramLatency", "0ns") / UnitAlgebra("1ps")).getRoundedValue();
+        programLink = configureSelfLink("programDelay", getTimeConverter("1ps"),
+            new SST::Event::Handler2<
+                RoCCAnalog<T>,
+                &RoCCAnalog<T>::handleProgramDone>(this));
+
         output->verbose(CALL_INFO, 1, 0,
-            "%s: arrays=%u in=%u*%u out=%u*%u\n",
+            "%s: arrays=%u in=%u*%u out=%u*%u%s\n",
             getName().c_str(),
-            numArrays, arrayInputSize, inputOperandSize, arrayOutputSize, outputOperandSize);
+            numArrays, arrayInputSize, inputOperandSize, arrayOutputSize, outputOperandSize,
+            tileLink ? " (shared tile)" : "");
     }
 
     ~RoCCAnalog() override {
         for (auto* c : roccQ) delete c;
         roccQ.clear();
         if (curr_resp) { delete curr_resp; curr_resp = nullptr; }
+        for (auto* r : netQ) delete r;
+        netQ.clear();
+        for (auto& d : remoteDeferred) delete d.second;
+        remoteDeferred.clear();
+        delete netSendHandler;
     }
 
     // ---- VanadisRoCCInterface ----
@@ -99,6 +196,7 @@ public:
     void push(SST::Vanadis::RoCCCommand* c) override {
         stat_rocc_issued->addData(1);
         roccQ.push_back(c);
+        issueCycle.push_back(curCycle);
     }
 
     SST::Vanadis::RoCCResponse* respond() override {
@@ -107,7 +205,8 @@ public:
 
     void init(unsigned int phase) override {
         memIF->init(phase);
-        array->init(phase);
+        if (array) array->init(phase);
+        if (nic) nic->init(phase);
         unsigned L = memIF->getLineSize();
         lineSize = (L == 0 ? 64 : L);
         if (phase == 0) {
@@ -116,7 +215,13 @@ public:
         }
     }
 
-    void tick(uint64_t /*cycle*/) override {
+    void setup() override {
+        if (nic) nic->setup();
+    }
+
+    void tick(uint64_t cycle) override {
+        curCycle = cycle;
+        recordCycle();
         if (busy || roccQ.empty()) return;
 
         busy     = true;
@@ -133,32 +238,88 @@ public:
                 startSetMatrix(rs1, static_cast<uint32_t>(rs2));
                 break;
 
-            case 0x2: // mvm.l: load input vector
+            case 0x2: // mvm.l: load input vector (rs2 bit 32: transposed length)
                 output->verbose(CALL_INFO, 9, 0, "%s: mvm.l addr=0x%" PRIx64 " aid=%" PRIu64 "\n",
                                 getName().c_str(), rs1, rs2);
-                startLoadVector(rs1, static_cast<uint32_t>(rs2));
+                startLoadVector(rs1, static_cast<uint32_t>(rs2), (rs2 >> 32) & 1);
                 break;
 
             case 0x3: // mvm: compute
                 output->verbose(CALL_INFO, 9, 0, "%s: mvm.compute aid=%" PRIu64 "\n",
                                 getName().c_str(), rs2);
-                startCompute(static_cast<uint32_t>(rs2));
+                startCompute(static_cast<uint32_t>(rs2), false);
                 break;
 
-            case 0x4: // mvm.s: store output vector to memory
+            case 0x4: // mvm.s: store output vector to memory (rs2 bit 32: transposed length)
                 output->verbose(CALL_INFO, 9, 0, "%s: mvm.s addr=0x%" PRIx64 " aid=%" PRIu64 "\n",
                                 getName().c_str(), rs1, rs2);
-                startStoreVector(rs1, static_cast<uint32_t>(rs2));
+                startStoreVector(rs1, static_cast<uint32_t>(rs2), (rs2 >> 32) & 1);
                 break;
 
             case 0x5: // mvm.mv: move output->input within arrays
                 output->verbose(CALL_INFO, 9, 0, "%s: mvm.mv src=%" PRIu64 " dst=%" PRIu64 "\n",
                                 getName().c_str(), rs1, rs2);
-                array->moveOutputToInput(static_cast<uint32_t>(rs1),
-                                         static_cast<uint32_t>(rs2));
+                startMove(static_cast<uint32_t>(rs1), static_cast<uint32_t>(rs2));
+                break;
+
+            case 0x6: // mvm.mv.remote: rs1=src array, rs2=(dst core << 32) | dst array
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.mv.remote src=%" PRIu64 " core=%" PRIu64 " dst=%" PRIu64 "\n",
+                                getName().c_str(), rs1, rs2 >> 32, rs2 & 0xffffffffULL);
+                startRemoteMove(static_cast<uint32_t>(rs1),
+                                static_cast<uint32_t>(rs2 >> 32),
+                                static_cast<uint32_t>(rs2 & 0xffffffffULL));
+                break;
+
+            case 0x9: // mvm.t: compute A^T x on the same programmed array
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.t aid=%" PRIu64 "\n",
+                                getName().c_str(), rs2);
+                startCompute(static_cast<uint32_t>(rs2), true);
+                break;
+
+            case 0xA: // mvm.mm.cfg: latch Y base, k and strides for mvm.mm
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.mm.cfg y=0x%" PRIx64 " rs2=0x%" PRIx64 "\n",
+                                getName().c_str(), rs1, rs2);
+                curOp = CurOp::Config;
+                batch = BatchConfig::decode(rs1, rs2);
                 completeRoCC(0);
                 break;
 
+            case 0xB: // mvm.mm: rs1=X base, rs2=aid; k vectors in, k vectors out
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.mm x=0x%" PRIx64 " aid=%" PRIu64 " k=%u\n",
+                                getName().c_str(), rs1, rs2, batch.k);
+                startMatMat(rs1, static_cast<uint32_t>(rs2));
+                break;
+
+            case 0xC: // mvm.l.bcast: rs1=addr, rs2=array bitmask; one read, every selected input buffer
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.l.bcast addr=0x%" PRIx64 " mask=0x%" PRIx64 "\n",
+                                getName().c_str(), rs1, rs2);
+                startLoadBroadcast(rs1, rs2);
+                break;
+
+            case 0xD: // mvm.free: release the array's backing model; rs2=aid
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.free aid=%" PRIu64 "\n",
+                                getName().c_str(), rs2);
+                startFree(static_cast<uint32_t>(rs2));
+                break;
+
+            case 0xE: // mvm.cfg: rs1=addr of the scale/offset block (0 = reset), rs2=aid
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.cfg addr=0x%" PRIx64 " aid=%" PRIu64 "\n",
+                                getName().c_str(), rs1, rs2);
+                startScaleConfig(rs1, static_cast<uint32_t>(rs2));
+                break;
+
+            case 0x7: // mvm.set.rows: rs1=addr of nrows full rows, rs2=aid|row0<<16|nrows<<32
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.set.rows addr=0x%" PRIx64 " rs2=0x%" PRIx64 "\n",
+                                getName().c_str(), rs1, rs2);
+                startSetRegion(rs1, MatrixRegion::rows(rs2, arrayInputSize));
+                break;
+
+            case 0x8: // mvm.set.region: rs1=addr of dense block, rs2=packed region (analogArrayOps.h)
+                output->verbose(CALL_INFO, 9, 0, "%s: mvm.set.region addr=0x%" PRIx64 " rs2=0x%" PRIx64 "\n",
+                                getName().c_str(), rs1, rs2);
+                startSetRegion(rs1, MatrixRegion::region(rs2));
+                break;
+
             default:
                 output->verbose(CALL_INFO, 0, 0, "%s: unknown func7=0x%x\n",
                                 getName().c_str(), curr_cmd->inst->func7);
@@ -185,16 +346,169 @@ public:
         auto* aev = static_cast<SST::Golem::ArrayEvent*>(ev);
         uint32_t aid = aev->getArrayID();
         if (aid < arrayBusy.size()) arrayBusy[aid] = false;
-        if (curOp == CurOp::Compute) completeRoCC(0);
+        if (!remoteDeferred.empty()) drainRemoteDeferred(aid);
+        if (curOp == CurOp::Compute || curOp == CurOp::ComputeT) {
+            completeRoCC(0);
+        } else if (curOp == CurOp::MatMat) {
+            const T* ys = static_cast<const T*>(arrayOps->getBatchOutput(aid));
+            const uint32_t es = memOutSize(aid);
+            outputPayload.assign(static_cast<size_t>(batch.k) * arrayOutputSize * es, 0);
+            for (size_t i = 0; i < static_cast<size_t>(batch.k) * arrayOutputSize; ++i) {
+                encodeOutput(aid, ys[i], &outputPayload[i * es]);
+            }
+            startBatchWrites();
+        }
+        delete ev;
+    }
+
+    // ---- Shared tile response ----
+    void handleTileEvent(Event* ev) {
+        auto* tev = static_cast<TileEvent*>(ev);
+        if (tev->op == TileOp::RemoteVec) {
+            // A peer's vector is in the tile's array: ack the sender (arg)
+            const auto src = static_cast<SST::Interfaces::SimpleNetwork::nid_t>(tev->arg);
+            tev->op = TileOp::RemoteAck;
+            tev->payload.clear();
+            sendNet(src, remoteHeaderBits, tev);
+            return;
+        }
+        if ((curOp == CurOp::Compute || curOp == CurOp::ComputeT || curOp == CurOp::MatMat) &&
+            arrayID < arrayBusy.size()) {
+            arrayBusy[arrayID] = false;
+        }
+        if (tev->status != 0) {
+            output->verbose(CALL_INFO, 0, 0, "%s: tile rejected op on array %u\n",
+                            getName().c_str(), tev->arrayID);
+            completeRoCC(tev->status);
+        } else if (curOp == CurOp::SetMatrix) {
+            completeAfterProgram(arrayOutputSize);
+        } else if (curOp == CurOp::SetRegion) {
+            completeAfterProgram(region.nrows);
+        } else if (curOp == CurOp::StoreVec) {
+            outputPayload = toMemoryBytes(arrayID, std::move(tev->payload));
+            outputPayload.resize(writeTotal, 0);
+            sendNextWriteChunk();
+        } else if (curOp == CurOp::MatMat) {
+            outputPayload = toMemoryBytes(arrayID, std::move(tev->payload));
+            outputPayload.resize(static_cast<size_t>(batch.k) * arrayOutputSize * memOutSize(arrayID), 0);
+            startBatchWrites();
+        } else if (curOp == CurOp::RemoteMove) {
+            tev->payload.resize(static_cast<size_t>(arrayOutputSize) * outputOperandSize, 0);
+            sendRemoteVec(std::move(tev->payload));
+        } else {
+            completeRoCC(0);
+        }
+        delete ev;
+    }
+
+    // ---- Programming delay elapsed ----
+    void handleProgramDone(Event* ev) {
         delete ev;
+        completeRoCC(0);
+    }
+
+    // ---- Remote move traffic (called via SimpleNetwork::Handler2) ----
+    bool handleNetEvent(int vn) {
+        auto* req = nic->recv(vn);
+        if (!req) return true;
+
+        auto* tev = static_cast<TileEvent*>(req->takePayload());
+        const SST::Interfaces::SimpleNetwork::nid_t src = req->src;
+        delete req;
+
+        if (tev->op == TileOp::RemoteVec) {
+            // An array mid-MVM takes the vector once it completes (a shared
+            // tile holds it in its port queue instead)
+            if (!tileLink && tev->arrayID < arrayBusy.size() && arrayBusy[tev->arrayID]) {
+                remoteDeferred.emplace_back(src, tev);
+                return true;
+            }
+            acceptRemote(src, tev);
+        } else if (curOp == CurOp::RemoteMove) {
+            completeRoCC(tev->status);
+            delete tev;
+        } else {
+            output->verbose(CALL_INFO, 0, 0, "%s: stray remote ack\n", getName().c_str());
+            delete tev;
+        }
+        return true;
+    }
+
+    // Peer output lands directly in our array's input buffer, then ack. The
+    // payload is in output-operand encoding; like mvm.mv, only the first
+    // min(rows, cols) entries fit the input buffer. On a shared tile the tile
+    // writes it and handleTileEvent acks.
+    void acceptRemote(SST::Interfaces::SimpleNetwork::nid_t src, TileEvent* tev) {
+        if (tileLink && tev->arrayID < numArrays) {
+            tev->arg = static_cast<uint64_t>(src);
+            tileLink->send(tev);
+            return;
+        }
+        if (tev->arrayID >= numArrays) {
+            tev->status = 1;
+        } else {
+            const size_t n = std::min<size_t>({ tev->payload.size() / outputOperandSize,
+                                                arrayOutputSize, arrayInputSize });
+            for (size_t i = 0; i < n; ++i) {
+                T v{};
+                std::memcpy(&v, &tev->payload[i * outputOperandSize], outputOperandSize);
+                array->setVectorItem(tev->arrayID, static_cast<int>(i), v);
+            }
+        }
+        tev->op = TileOp::RemoteAck;
+        tev->payload.clear();
+        sendNet(src, remoteHeaderBits, tev);
+    }
+
+    // Remote vectors that waited for array aid to finish computing
+    void drainRemoteDeferred(uint32_t aid) {
+        for (auto it = remoteDeferred.begin(); it != remoteDeferred.end(); ) {
+            if (it->second->arrayID != aid) { ++it; continue; }
+            acceptRemote(it->first, it->second);
+            it = remoteDeferred.erase(it);
+        }
+    }
+
+    bool drainNetQueue(int vn) {
+        while (!netQ.empty() && nic->spaceToSend(vn, netQ.front()->size_in_bits)) {
+            nic->send(netQ.front(), vn);
+            netQ.pop_front();
+        }
+        return !netQ.empty();
     }
 
 private:
-    enum class CurOp { None, SetMatrix, LoadVec, StoreVec, Compute };
+    enum class CurOp { None, SetMatrix, LoadVec, StoreVec, Compute, Move, RemoteMove, SetRegion,
+                       ComputeT, MatMat, Config, LoadBcast, Free, ScaleCfg };
+    enum class Wait  { None, Memory, Array, Network };
+
+    static constexpr size_t kNumOps = 14;
+    static constexpr const char* kOpNames[kNumOps] =
+        { "none", "set", "load", "store", "compute", "move", "remote", "region", "compute_t",
+          "mm", "cfg", "bcast", "free", "scale" };
+    static constexpr size_t opIdx(CurOp op) { return static_cast<size_t>(op); }
+
+    // Per-cycle occupancy, busy/idle and stall attribution
+    void recordCycle() {
+        stat_queue_occupancy->addData(roccQ.size());
+        if (!busy) { stat_idle_cycles->addData(1); return; }
+        stat_busy_cycles->addData(1);
+        switch (waitingOn) {
+            case Wait::Memory:  stat_stall_memory->addData(1);  break;
+            case Wait::Array:   stat_stall_array->addData(1);   break;
+            case Wait::Network: stat_stall_network->addData(1); break;
+            default: break;
+        }
+        if (stat_array_busy.empty() || !stat_array_busy[0]->isEnabled()) return;
+        for (size_t a = 0; a < arrayBusy.size() && a < stat_array_busy.size(); ++a) {
+            if (arrayBusy[a]) stat_array_busy[a]->addData(1);
+        }
+    }
 
     // ---- Op lifecycle helpers ----
     void resetOpState() {
         curOp              = CurOp::None;
+        waitingOn          = Wait::None;
         arrayID            = 0;
         rdBase             = 0;
         wrBase             = 0;
@@ -202,12 +516,108 @@ private:
         readTotal          = 0;
         writeOffset        = 0;
         writeTotal         = 0;
+        wrPayloadBase      = 0;
+        batchIdx           = 0;
+        batchXBase         = 0;
+        bcastMask          = 0;
         outputPayload.clear();
+        stagePayload.clear();
+        region             = MatrixRegion{};
+    }
+
+    // Reads for mvm.set* / mvm.l* / mvm.mm are done; commit locally or ship to the tile
+    void finishRead() {
+        if (curOp == CurOp::ScaleCfg) {
+            scaleRegs[arrayID] = ScaleConfig::decode(stagePayload.data());
+            completeRoCC(0);
+            return;
+        }
+        if (curOp == CurOp::LoadBcast) {
+            // One conversion on the read path: the lowest selected array's registers
+            if (tileLink) {
+                auto* tev = new TileEvent(TileOp::LoadBcast, arrayID);
+                tev->arg     = bcastMask;
+                tev->payload = toArrayBytes(arrayID, std::move(stagePayload));
+                waitingOn = Wait::Array;
+                tileLink->send(tev);
+                return;
+            }
+            std::vector<T> x(arrayInputSize);
+            const uint32_t es = memInSize(arrayID);
+            for (size_t i = 0; i < x.size(); ++i) x[i] = decodeInput(arrayID, &stagePayload[i * es]);
+            if (arrayOps) {
+                arrayOps->setVectorBlock(bcastMask, arrayInputSize, x.data());
+            } else {
+                for (uint32_t a = 0; a < numArrays; ++a) {
+                    if (!((bcastMask >> a) & 1)) continue;
+                    for (uint32_t i = 0; i < arrayInputSize; ++i) array->setVectorItem(a, i, x[i]);
+                }
+            }
+            completeRoCC(0);
+            return;
+        }
+        if (curOp == CurOp::MatMat) {
+            // Next strided input vector, or hand all k to the array
+            if (++batchIdx < batch.k) {
+                rdBase     = batchXBase + static_cast<uint64_t>(batchIdx) * xStrideBytes();
+                readOffset = 0;
+                sendNextReadChunk();
+                return;
+            }
+            waitingOn = Wait::Array;
+            if (arrayID >= arrayBusy.size()) arrayBusy.resize(arrayID + 1, false);
+            arrayBusy[arrayID] = true;
+            if (tileLink) {
+                auto* tev = new TileEvent(TileOp::MatMat, arrayID);
+                tev->arg     = batch.k;
+                tev->payload = toArrayBytes(arrayID, std::move(stagePayload));
+                tileLink->send(tev);
+                return;
+            }
+            std::vector<T> xs(static_cast<size_t>(batch.k) * arrayInputSize);
+            const uint32_t es = memInSize(arrayID);
+            for (size_t i = 0; i < xs.size(); ++i) xs[i] = decodeInput(arrayID, &stagePayload[i * es]);
+            arrayOps->beginBatchComputation(arrayID, batch.k, xs.data()); // via handleArrayEvent
+            return;
+        }
+        if (tileLink) {
+            const TileOp op = curOp == CurOp::SetMatrix ? TileOp::SetMatrix
+                            : curOp == CurOp::SetRegion ? TileOp::SetRegion
+                            : TileOp::LoadVec;
+            auto* tev = new TileEvent(op, arrayID);
+            tev->arg     = region.encode();
+            tev->payload = op == TileOp::LoadVec ? toArrayBytes(arrayID, std::move(stagePayload))
+                                                 : std::move(stagePayload);
+            waitingOn = Wait::Array;
+            tileLink->send(tev);
+            return;
+        }
+        if (curOp == CurOp::SetRegion) {
+            std::vector<T> block(region.cells());
+            for (size_t i = 0; i < block.size(); ++i) {
+                std::memcpy(&block[i], &stagePayload[i * inputOperandSize], inputOperandSize);
+            }
+            arrayOps->setMatrixRegion(arrayID, region.row0, region.nrows,
+                                      region.col0, region.ncols, block.data());
+            completeAfterProgram(region.nrows);
+        } else if (curOp == CurOp::SetMatrix) {
+            completeAfterProgram(arrayOutputSize);
+        } else {
+            completeRoCC(0);
+        }
+    }
+
+    // Programming cost scales with the rows rewritten
+    void completeAfterProgram(uint32_t rows) {
+        const SimTime_t delay = static_cast<SimTime_t>(rows) * rowProgramPs;
+        if (delay == 0) { completeRoCC(0); return; }
+        waitingOn = Wait::Array;
+        programLink->send(delay, new ArrayEvent(arrayID));
     }
 
     // Single-outstanding, cacheline-chunked reads
     void sendNextReadChunk() {
-        if (readOffset >= readTotal) { completeRoCC(0); return; }
+        if (readOffset >= readTotal) { finishRead(); return; }
 
         const uint64_t addr  = rdBase + readOffset;
         const uint64_t align = (lineSize ? (addr % lineSize) : 0);
@@ -216,6 +626,7 @@ private:
             : static_cast<uint32_t>(std::min<uint64_t>(lineSize,         readTotal - readOffset));
 
         auto* r = new Interfaces::StandardMem::Read(addr, size /*flags=0*/);
+        waitingOn = Wait::Memory;
         memIF->send(r);
         // NOTE: We advance offset on response, not here (one in-flight)
     }
@@ -230,14 +641,16 @@ private:
             ? static_cast<uint32_t>(std::min<uint64_t>(lineSize - align, writeTotal - writeOffset))
             : static_cast<uint32_t>(std::min<uint64_t>(lineSize,         writeTotal - writeOffset));
 
-        std::vector<uint8_t> chunk(outputPayload.begin() + writeOffset,
-                                   outputPayload.begin() + writeOffset + size);
+        const size_t from = wrPayloadBase + writeOffset;
+        std::vector<uint8_t> chunk(outputPayload.begin() + from,
+                                   outputPayload.begin() + from + size);
 
         auto* w = new Interfaces::StandardMem::Write(
             addr, size, chunk,
             false /*noncacheable*/, 0 /*writeThrough*/,
             addr /*vAddr*/, 0, 0
         );
+        waitingOn = Wait::Memory;
         memIF->send(w);
         // Advance on response (one in-flight)
     }
@@ -248,6 +661,7 @@ private:
         arrayID    = aid;
         rdBase     = base;
         readOffset = 0;
+        if (tileLink) stagePayload.reserve(static_cast<size_t>(arrayOutputSize) * arrayInputSize * inputOperandSize);
         // matrix bytes: (rows=arrayOutputSize) x (cols=arrayInputSize) x elemSize
         readTotal  = static_cast<uint64_t>(arrayOutputSize) *
                      static_cast<uint64_t>(arrayInputSize) *
@@ -255,48 +669,290 @@ private:
         sendNextReadChunk();
     }
 
-    void startLoadVector(uint64_t base, uint32_t aid) {
+    // mvm.mm: stream k strided input vectors, one batched MVM, k strided outputs
+    void startMatMat(uint64_t xBase, uint32_t aid) {
+        curOp   = CurOp::MatMat;
+        arrayID = aid;
+        if (batch.k == 0 || aid >= numArrays || (!tileLink && !arrayOps)) {
+            output->verbose(CALL_INFO, 0, 0, "%s: mvm.mm needs mvm.mm.cfg k>0 and a batched array (aid=%u k=%u)\n",
+                            getName().c_str(), aid, batch.k);
+            completeRoCC(1);
+            return;
+        }
+        batchIdx   = 0;
+        batchXBase = xBase;
+        rdBase     = xBase;
+        readOffset = 0;
+        readTotal  = static_cast<uint64_t>(arrayInputSize) * memInSize(aid);
+        stagePayload.reserve(static_cast<size_t>(batch.k) * readTotal);
+        sendNextReadChunk();
+    }
+
+    void startBatchWrites() {
+        batchIdx      = 0;
+        wrBase        = batch.yBase;
+        wrPayloadBase = 0;
+        writeOffset   = 0;
+        writeTotal    = static_cast<uint64_t>(arrayOutputSize) * memOutSize(arrayID);
+        sendNextWriteChunk();
+    }
+
+    uint64_t xStrideBytes() const {
+        return static_cast<uint64_t>(batch.xStride ? batch.xStride : arrayInputSize) * memInSize(arrayID);
+    }
+
+    uint64_t yStrideBytes() const {
+        return static_cast<uint64_t>(batch.yStride ? batch.yStride : arrayOutputSize) * memOutSize(arrayID);
+    }
+
+    // mvm.set.rows / mvm.set.region: only the selected block is read and reprogrammed
+    void startSetRegion(uint64_t base, const MatrixRegion& r) {
+        curOp   = CurOp::SetRegion;
+        arrayID = r.arrayID;
+        region  = r;
+        if (!r.fits(arrayOutputSize, arrayInputSize) || r.arrayID >= numArrays || (!tileLink && !arrayOps)) {
+            output->verbose(CALL_INFO, 0, 0, "%s: bad/unsupported region rows %u+%u cols %u+%u on array %u\n",
+                            getName().c_str(), r.row0, r.nrows, r.col0, r.ncols, r.arrayID);
+            completeRoCC(1);
+            return;
+        }
+        rdBase     = base;
+        readOffset = 0;
+        readTotal  = r.cells() * inputOperandSize;
+        stagePayload.reserve(readTotal);
+        sendNextReadChunk();
+    }
+
+    void startLoadVector(uint64_t base, uint32_t aid, bool transposed) {
         curOp      = CurOp::LoadVec;
         arrayID    = aid;
         rdBase     = base;
         readOffset = 0;
-        // vector bytes: arrayInputSize x elemSize
-        readTotal  = static_cast<uint64_t>(arrayInputSize) *
-                     static_cast<uint64_t>(inputOperandSize);
+        // vector bytes: arrayInputSize x elemSize (arrayOutputSize for mvm.t operands)
+        readTotal  = static_cast<uint64_t>(transposed ? arrayOutputSize : arrayInputSize) *
+                     static_cast<uint64_t>(memInSize(aid));
         sendNextReadChunk();
     }
 
-    void startCompute(uint32_t aid) {
-        curOp   = CurOp::Compute;
+    // mvm.l.bcast: read the operand once and fan it out to every array in the mask
+    void startLoadBroadcast(uint64_t base, uint64_t mask) {
+        curOp     = CurOp::LoadBcast;
+        bcastMask = mask;
+        const uint64_t valid = numArrays >= 64 ? ~0ULL : ((1ULL << numArrays) - 1);
+        if (mask == 0 || (mask & ~valid)) {
+            output->verbose(CALL_INFO, 0, 0, "%s: mvm.l.bcast bad array mask 0x%" PRIx64 "\n",
+                            getName().c_str(), mask);
+            completeRoCC(1);
+            return;
+        }
+        arrayID    = static_cast<uint32_t>(__builtin_ctzll(mask)); // lowest selected array
+        rdBase     = base;
+        readOffset = 0;
+        readTotal  = static_cast<uint64_t>(arrayInputSize) * memInSize(arrayID);
+        stagePayload.reserve(readTotal);
+        sendNextReadChunk();
+    }
+
+    // mvm.cfg: read the four conversion registers of one array (rs1 = 0 resets them)
+    void startScaleConfig(uint64_t base, uint32_t aid) {
+        curOp   = CurOp::ScaleCfg;
+        arrayID = aid;
+        if (aid >= numArrays) {
+            output->verbose(CALL_INFO, 0, 0, "%s: mvm.cfg bad array %u\n", getName().c_str(), aid);
+            completeRoCC(1);
+            return;
+        }
+        if (base == 0) {
+            scaleRegs[aid] = ScaleConfig{};
+            completeRoCC(0);
+            return;
+        }
+        rdBase     = base;
+        readOffset = 0;
+        readTotal  = ScaleConfig::kBytes;
+        stagePayload.reserve(readTotal);
+        sendNextReadChunk();
+    }
+
+    void startFree(uint32_t aid) {
+        curOp   = CurOp::Free;
         arrayID = aid;
+        if (aid >= numArrays || (!tileLink && !arrayOps)) {
+            output->verbose(CALL_INFO, 0, 0, "%s: mvm.free unsupported on array %u\n",
+                            getName().c_str(), aid);
+            completeRoCC(1);
+            return;
+        }
+        if (tileLink) {
+            waitingOn = Wait::Array;
+            tileLink->send(new TileEvent(TileOp::Free, aid));
+            return;
+        }
+        arrayOps->freeArray(aid);
+        completeRoCC(0);
+    }
+
+    void startCompute(uint32_t aid, bool transposed) {
+        curOp     = transposed ? CurOp::ComputeT : CurOp::Compute;
+        arrayID   = aid;
+        if (transposed && !tileLink && !arrayOps) {
+            output->verbose(CALL_INFO, 0, 0, "%s: array has no transpose path\n", getName().c_str());
+            completeRoCC(1);
+            return;
+        }
+        waitingOn = Wait::Array;
         if (arrayID >= arrayBusy.size()) arrayBusy.resize(arrayID + 1, false);
         arrayBusy[arrayID] = true;
-        array->beginComputation(arrayID); // completion via handleArrayEvent
+        if (tileLink) {
+            tileLink->send(new TileEvent(transposed ? TileOp::ComputeT : TileOp::Compute, aid));
+            return;
+        }
+        // completion via handleArrayEvent
+        if (transposed) arrayOps->beginTransposeComputation(arrayID);
+        else            array->beginComputation(arrayID);
     }
 
-    void startStoreVector(uint64_t dst, uint32_t aid) {
+    void startStoreVector(uint64_t dst, uint32_t aid, bool transposed) {
         curOp       = CurOp::StoreVec;
         arrayID     = aid;
         wrBase      = dst;
         writeOffset = 0;
-        // bytes: arrayOutputSize x elemSize(out)
-        writeTotal  = static_cast<uint64_t>(arrayOutputSize) *
-                      static_cast<uint64_t>(outputOperandSize);
-
-        outputPayload.resize(writeTotal);
-
-        // Pack output vector into byte payload
-        auto& outVec = *static_cast<std::vector<T>*>(array->getOutputVector(arrayID));
-        for (size_t i = 0; i < static_cast<size_t>(arrayOutputSize); ++i) {
-            T v = outVec[i];
-            const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
-            for (size_t j = 0; j < static_cast<size_t>(outputOperandSize); ++j) {
-                outputPayload[i * outputOperandSize + j] = p[j];
-            }
+        // bytes: arrayOutputSize x elemSize(out) (arrayInputSize after mvm.t)
+        const uint32_t count = transposed ? arrayInputSize : arrayOutputSize;
+        writeTotal  = static_cast<uint64_t>(count) *
+                      static_cast<uint64_t>(memOutSize(aid));
+
+        // Shared tile packs the output and replies via handleTileEvent(...)
+        if (tileLink) {
+            waitingOn = Wait::Array;
+            tileLink->send(new TileEvent(TileOp::StoreVec, aid));
+            return;
         }
+
+        packOutput(arrayID, outputPayload, count, true);
         sendNextWriteChunk();
     }
 
+    // Pack `count` entries of an array's output vector into a byte payload,
+    // through the array's store registers when it goes to memory
+    void packOutput(uint32_t aid, std::vector<uint8_t>& bytes, uint32_t count, bool toMemory) {
+        const uint32_t es = toMemory ? memOutSize(aid) : outputOperandSize;
+        bytes.assign(static_cast<size_t>(count) * es, 0);
+        auto& outVec = *static_cast<std::vector<T>*>(array->getOutputVector(aid));
+        for (size_t i = 0; i < static_cast<size_t>(count) && i < outVec.size(); ++i) {
+            if (toMemory) {
+                encodeOutput(aid, outVec[i], &bytes[i * es]);
+            } else {
+                T v = outVec[i];
+                std::memcpy(&bytes[i * es], &v, es);
+            }
+        }
+    }
+
+    // ---- mvm.cfg conversion (see ScaleConfig) ----
+    bool scaled(uint32_t aid) const { return aid < scaleRegs.size() && scaleRegs[aid].enabled; }
+    uint32_t memInSize(uint32_t aid) const  { return scaled(aid) ? ScaleConfig::kElemSize : inputOperandSize; }
+    uint32_t memOutSize(uint32_t aid) const { return scaled(aid) ? ScaleConfig::kElemSize : outputOperandSize; }
+
+    T decodeInput(uint32_t aid, const uint8_t* p) const {
+        T v{};
+        if (!scaled(aid)) { std::memcpy(&v, p, inputOperandSize); return v; }
+        float x;
+        std::memcpy(&x, p, sizeof(x));
+        return scaleRegs[aid].template toArray<T>(x);
+    }
+
+    void encodeOutput(uint32_t aid, T v, uint8_t* p) const {
+        if (!scaled(aid)) { std::memcpy(p, &v, outputOperandSize); return; }
+        const float y = scaleRegs[aid].toMemory(v);
+        std::memcpy(p, &y, sizeof(y));
+    }
+
+    // Memory-format input operands -> array-format bytes for the shared tile
+    std::vector<uint8_t> toArrayBytes(uint32_t aid, std::vector<uint8_t>&& mem) const {
+        if (!scaled(aid)) return std::move(mem);
+        const size_t n = mem.size() / ScaleConfig::kElemSize;
+        std::vector<uint8_t> out(n * inputOperandSize, 0);
+        for (size_t i = 0; i < n; ++i) {
+            const T v = decodeInput(aid, &mem[i * ScaleConfig::kElemSize]);
+            std::memcpy(&out[i * inputOperandSize], &v, inputOperandSize);
+        }
+        return out;
+    }
+
+    // Array-format output bytes from the shared tile -> memory format
+    std::vector<uint8_t> toMemoryBytes(uint32_t aid, std::vector<uint8_t>&& arr) const {
+        if (!scaled(aid)) return std::move(arr);
+        const size_t n = arr.size() / outputOperandSize;
+        std::vector<uint8_t> out(n * ScaleConfig::kElemSize, 0);
+        for (size_t i = 0; i < n; ++i) {
+            T v{};
+            std::memcpy(&v, &arr[i * outputOperandSize], outputOperandSize);
+            encodeOutput(aid, v, &out[i * ScaleConfig::kElemSize]);
+        }
+        return out;
+    }
+
+    void startMove(uint32_t src, uint32_t dst) {
+        curOp   = CurOp::Move;
+        arrayID = src;
+        if (tileLink) {
+            auto* tev = new TileEvent(TileOp::Move, src);
+            tev->aux = dst;
+            waitingOn = Wait::Array;
+            tileLink->send(tev);
+            return;
+        }
+        array->moveOutputToInput(src, dst);
+        completeRoCC(0);
+    }
+
+    // Ship our output vector to another core's array input over the network.
+    // Completes when the peer acks, so a following mvm on that core sees the data.
+    // On a shared tile the output is fetched from the tile first.
+    void startRemoteMove(uint32_t src, uint32_t dstCore, uint32_t dst) {
+        curOp   = CurOp::RemoteMove;
+        arrayID = src;
+        if (!nic || src >= numArrays) {
+            output->verbose(CALL_INFO, 0, 0, "%s: mvm.mv.remote unavailable\n", getName().c_str());
+            completeRoCC(1);
+            return;
+        }
+        remoteDstCore  = dstCore;
+        remoteDstArray = dst;
+        if (tileLink) {
+            waitingOn = Wait::Array;
+            tileLink->send(new TileEvent(TileOp::StoreVec, src)); // raw output via handleTileEvent
+            return;
+        }
+        std::vector<uint8_t> payload;
+        packOutput(src, payload, arrayOutputSize, false);
+        sendRemoteVec(std::move(payload));
+    }
+
+    void sendRemoteVec(std::vector<uint8_t>&& payload) {
+        auto* tev = new TileEvent(TileOp::RemoteVec, remoteDstArray);
+        tev->payload = std::move(payload);
+        stat_energy_net->addData(netEnergy * tev->payload.size());
+        stat_bytes_written[opIdx(CurOp::RemoteMove)]->addData(tev->payload.size());
+        waitingOn = Wait::Network;
+        sendNet(remoteNidBase + remoteDstCore,
+                remoteHeaderBits + 8 * static_cast<uint32_t>(tev->payload.size()), tev);
+    }
+
+    // Cost is carried by the packet size; Merlin models serialization and hops
+    void sendNet(SST::Interfaces::SimpleNetwork::nid_t dest, uint32_t bits, TileEvent* tev) {
+        auto* req = new SST::Interfaces::SimpleNetwork::Request(
+            dest, nic->getEndpointID(), bits, true, true, tev);
+        req->vn = remoteVN;
+        if (netQ.empty() && nic->spaceToSend(remoteVN, bits)) {
+            nic->send(req, remoteVN);
+            return;
+        }
+        if (netQ.empty()) nic->setNotifyOnSend(netSendHandler);
+        netQ.push_back(req);
+    }
+
     // ---- Mem responses ----
     void handleReadResp(Interfaces::StandardMem::ReadResp* ev) {
         if (ev->getFail()) {
@@ -308,8 +964,14 @@ private:
 
         const auto& bytes = ev->data;
         const uint64_t baseBefore = readOffset;
-
-        if (curOp == CurOp::SetMatrix) {
+        stat_energy_mem->addData(memEnergy * bytes.size());
+        if (auto* st = stat_bytes_read[opIdx(curOp)]) st->addData(bytes.size());
+
+        if (curOp == CurOp::SetRegion || curOp == CurOp::MatMat || curOp == CurOp::LoadBcast ||
+            curOp == CurOp::ScaleCfg ||
+            (tileLink && (curOp == CurOp::SetMatrix || curOp == CurOp::LoadVec))) {
+            stagePayload.insert(stagePayload.end(), bytes.begin(), bytes.end());
+        } else if (curOp == CurOp::SetMatrix) {
             for (size_t i = 0; i < bytes.size(); i += inputOperandSize) {
                 T v{};
                 std::memcpy(&v, &bytes[i], inputOperandSize);
@@ -317,11 +979,10 @@ private:
                 array->setMatrixItem(arrayID, static_cast<int>(idx), v);
             }
         } else if (curOp == CurOp::LoadVec) {
-            for (size_t i = 0; i < bytes.size(); i += inputOperandSize) {
-                T v{};
-                std::memcpy(&v, &bytes[i], inputOperandSize);
-                size_t idx = (baseBefore + i) / inputOperandSize;
-                array->setVectorItem(arrayID, static_cast<int>(idx), v);
+            const uint32_t es = memInSize(arrayID);
+            for (size_t i = 0; i < bytes.size(); i += es) {
+                size_t idx = (baseBefore + i) / es;
+                array->setVectorItem(arrayID, static_cast<int>(idx), decodeInput(arrayID, &bytes[i]));
             }
         } else {
             output->verbose(CALL_INFO, 0, 0, "%s: ReadResp w/ invalid curOp\n", getName().c_str());
@@ -331,7 +992,7 @@ private:
 
         readOffset += bytes.size();
         if (readOffset < readTotal) sendNextReadChunk();
-        else                        completeRoCC(0);
+        else                        finishRead();
     }
 
     void handleWriteResp(Interfaces::StandardMem::WriteResp* ev) {
@@ -342,7 +1003,7 @@ private:
             return;
         }
 
-        if (curOp != CurOp::StoreVec) {
+        if (curOp != CurOp::StoreVec && curOp != CurOp::MatMat) {
             output->verbose(CALL_INFO, 0, 0, "%s: WriteResp w/ invalid curOp\n", getName().c_str());
             completeRoCC(1);
             return;
@@ -357,8 +1018,19 @@ private:
             : static_cast<uint32_t>(std::min<uint64_t>(lineSize, writeTotal - writeOffset));
 
         writeOffset += last;
-        if (writeOffset < writeTotal) sendNextWriteChunk();
-        else                          completeRoCC(0);
+        stat_energy_mem->addData(memEnergy * last);
+        if (auto* st = stat_bytes_written[opIdx(curOp)]) st->addData(last);
+        if (writeOffset < writeTotal) { sendNextWriteChunk(); return; }
+
+        // mvm.mm: next strided output vector
+        if (curOp == CurOp::MatMat && ++batchIdx < batch.k) {
+            wrBase        = batch.yBase + static_cast<uint64_t>(batchIdx) * yStrideBytes();
+            wrPayloadBase = static_cast<size_t>(batchIdx) * writeTotal;
+            writeOffset   = 0;
+            sendNextWriteChunk();
+            return;
+        }
+        completeRoCC(0);
     }
 
     // ---- Complete and produce response back to the core ----
@@ -369,6 +1041,13 @@ private:
         roccQ.pop_front();
         busy = false;
 
+        const uint64_t issued = issueCycle.front();
+        issueCycle.pop_front();
+        if (curOp != CurOp::None) {
+            stat_op_count[opIdx(curOp)]->addData(1);
+            stat_op_latency[opIdx(curOp)]->addData(curCycle - issued);
+        }
+
         curr_resp = new SST::Vanadis::RoCCResponse(finished->inst->rd, rd_val);
         delete finished;
 
@@ -386,6 +1065,10 @@ private:
     // Subcomponents
     SST::Interfaces::StandardMem* memIF {nullptr};
     SST::Golem::ComputeArray*     array {nullptr};
+    AnalogArrayOps*               arrayOps {nullptr};
+    SST::Link*                    programLink {nullptr};
+    SST::Link*                    tileLink {nullptr};
+    SST::Interfaces::SimpleNetwork* nic   {nullptr};
 
     // Params / sizes
     uint32_t numArrays{1};
@@ -395,11 +1078,34 @@ private:
     uint32_t outputOperandSize{4};
     unsigned lineSize{64};
 
+    // Energy
+    double             memEnergy{0.0};
+    double             netEnergy{0.0};
+    Statistic<double>* stat_energy_mem{nullptr};
+    Statistic<double>* stat_energy_net{nullptr};
+
+    // Activity statistics
+    uint64_t                           curCycle{0};
+    std::deque<uint64_t>               issueCycle;   // parallel to roccQ
+    Statistic<uint64_t>*               stat_op_count[kNumOps]{};
+    Statistic<uint64_t>*               stat_op_latency[kNumOps]{};
+    Statistic<uint64_t>*               stat_bytes_read[kNumOps]{};
+    Statistic<uint64_t>*               stat_bytes_written[kNumOps]{};
+    Statistic<uint64_t>*               stat_busy_cycles{nullptr};
+    Statistic<uint64_t>*               stat_idle_cycles{nullptr};
+    Statistic<uint64_t>*               stat_stall_memory{nullptr};
+    Statistic<uint64_t>*               stat_stall_array{nullptr};
+    Statistic<uint64_t>*               stat_stall_network{nullptr};
+    Statistic<uint64_t>*               stat_queue_occupancy{nullptr};
+    std::vector<Statistic<uint64_t>*>  stat_array_busy;
+
     // Array bookkeeping
     std::vector<bool> arrayBusy;
+    std::deque<std::pair<SST::Interfaces::SimpleNetwork::nid_t, TileEvent*>> remoteDeferred;
 
     // Current operation state
     CurOp     curOp{CurOp::None};
+    Wait      waitingOn{Wait::None};
     uint32_t  arrayID{0};
 
     uint64_t  rdBase{0};
@@ -410,6 +1116,30 @@ private:
     uint64_t  writeOffset{0};
     uint64_t  writeTotal{0};
     std::vector<uint8_t> outputPayload;
+    std::vector<uint8_t> stagePayload;  // staged operand bytes (shared tile / region ops)
+    MatrixRegion         region;        // mvm.set.rows / mvm.set.region target
+    uint64_t             rowProgramPs{0};
+
+    // mvm.mm state; `batch` persists across commands (set by mvm.mm.cfg)
+    BatchConfig          batch;
+    uint32_t             batchIdx{0};
+    uint64_t             batchXBase{0};
+    size_t               wrPayloadBase{0};
+
+    // mvm.l.bcast destination arrays
+    uint64_t             bcastMask{0};
+
+    // mvm.cfg load/store conversion registers, per array
+    std::vector<ScaleConfig> scaleRegs;
+
+    // Remote moves
+    int      remoteVN{2};
+    uint64_t remoteNidBase{0};
+    uint32_t remoteDstCore{0};      // mvm.mv.remote in flight
+    uint32_t remoteDstArray{0};
+    uint32_t remoteHeaderBits{64};
+    std::deque<SST::Interfaces::SimpleNetwork::Request*> netQ;
+    SST::Interfaces::SimpleNetwork::HandlerBase*         netSendHandler{nullptr};
 };
 
 } // namespace Golem
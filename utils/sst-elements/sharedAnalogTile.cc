@@ -0,0 +1,9 @@
+// Copyright 2009-2025 NTESS.
+// This file is part of the SST software package.
+
+// Compiled into libgolem so the SharedAnalogTileFloat component is
+// registered with the ELI.
+
+#include <sst_config.h>
+
+#include "sharedAnalogTile.h"
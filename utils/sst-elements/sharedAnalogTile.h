@@ -0,0 +1,496 @@
+// Copyright 2009-2025 NTESS.
+// This file is part of the SST software package.
+
+#ifndef _H_ANALOG_SHARED_TILE
+#define _H_ANALOG_SHARED_TILE
+
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/output.h>
+
+#include <sst/elements/golem/array/computeArray.h>
+
+#include "analogTileEvent.h"
+#include "analogArrayOps.h"
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+
+namespace SST {
+namespace Golem {
+
+// One bank of analog arrays shared by several cores. Every core keeps its own
+// RoCCAnalog front-end (memory traffic goes through that core's D-side), but
+// the front-end forwards array operations over its "tile" link to one of the
+// N "port%d" links here. Each port has its own command queue; every cycle the
+// tile grants up to `grantsPerCycle` head-of-queue commands whose target
+// array is idle, picked round-robin or by static port priority.
+//
+// The array ID space is the tile's pool: software must keep cores of the
+// same tile on disjoint array IDs.
+template <typename T>
+class SharedAnalogTile : public SST::Component {
+
+public:
+    SharedAnalogTile(ComponentId_t id, Params& params)
+        : Component(id)
+    {
+        const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+        out.init("[SharedTile] ", verbose, 0, SST::Output::STDOUT);
+
+        numPorts          = params.find<uint32_t>("numPorts", 1);
+        numArrays         = params.find<uint32_t>("numArrays", 1);
+        inputOperandSize  = params.find<uint32_t>("inputOperandSize", 4);
+        outputOperandSize = params.find<uint32_t>("outputOperandSize", 4);
+        arrayInputSize    = params.find<uint32_t>("arrayInputSize", 2);
+        arrayOutputSize   = params.find<uint32_t>("arrayOutputSize", 2);
+        grantsPerCycle    = params.find<uint32_t>("grantsPerCycle", 1);
+        if (numPorts == 0 || grantsPerCycle == 0) {
+            out.fatal(CALL_INFO, -1, "%s: numPorts and grantsPerCycle must be > 0\n",
+                      getName().c_str());
+        }
+
+        // Arbitration policy
+        const std::string arb = params.find<std::string>("arbitration", "roundrobin");
+        if (arb == "roundrobin") {
+            policy = Arbitration::RoundRobin;
+        } else if (arb == "priority") {
+            policy = Arbitration::Priority;
+        } else {
+            out.fatal(CALL_INFO, -1, "%s: unknown arbitration '%s' (roundrobin|priority)\n",
+                      getName().c_str(), arb.c_str());
+        }
+
+        // Lower value wins; default is port index order
+        std::vector<uint32_t> prio;
+        params.find_array<uint32_t>("portPriority", prio);
+        if (prio.empty()) {
+            prio.resize(numPorts);
+            std::iota(prio.begin(), prio.end(), 0);
+        } else if (prio.size() != numPorts) {
+            out.fatal(CALL_INFO, -1, "%s: portPriority has %zu entries, numPorts=%u\n",
+                      getName().c_str(), prio.size(), numPorts);
+        }
+        priorityOrder.resize(numPorts);
+        std::iota(priorityOrder.begin(), priorityOrder.end(), 0);
+        std::stable_sort(priorityOrder.begin(), priorityOrder.end(),
+                         [&prio](uint32_t a, uint32_t b) { return prio[a] < prio[b]; });
+
+        // Shared array pool: completion comes via handleArrayEvent(...)
+        array = loadUserSubComponent<SST::Golem::ComputeArray>(
+            "array",
+            ComponentInfo::SHARE_NONE,
+            getTimeConverter("1ps"),
+            new SST::Event::Handler2<
+                SharedAnalogTile<T>,
+                &SharedAnalogTile<T>::handleArrayEvent>(this)
+        );
+        if (!array) {
+            out.fatal(CALL_INFO, -1, "%s failed to load array subcomponent\n", getName().c_str());
+        }
+        arrayOps = dynamic_cast<AnalogArrayOps*>(array);
+
+        // Front-end ports
+        ports.resize(numPorts, nullptr);
+        portQ.resize(numPorts);
+        for (uint32_t p = 0; p < numPorts; ++p) {
+            ports[p] = configureLink("port" + std::to_string(p),
+                new SST::Event::Handler2<
+                    SharedAnalogTile<T>,
+                    &SharedAnalogTile<T>::handlePortEvent,
+                    uint32_t>(this, p));
+            if (!ports[p]) {
+                out.fatal(CALL_INFO, -1, "%s: port%u is not connected\n", getName().c_str(), p);
+            }
+        }
+
+        clockHandler = new SST::Clock::Handler2<SharedAnalogTile<T>, &SharedAnalogTile<T>::tick>(this);
+        clockTC      = registerClock(params.find<std::string>("clock", "1GHz"), clockHandler);
+
+        // Statistics
+        stat_grants          = registerStatistic<uint64_t>("grants");
+        stat_arb_conflicts   = registerStatistic<uint64_t>("arb_conflicts");
+        stat_array_conflicts = registerStatistic<uint64_t>("array_conflicts");
+        for (uint32_t p = 0; p < numPorts; ++p) {
+            const std::string sub = "port" + std::to_string(p);
+            stat_port_requests.push_back(registerStatistic<uint64_t>("port_requests", sub));
+            stat_port_wait.push_back(registerStatistic<uint64_t>("port_wait_cycles", sub));
+        }
+
+        out.verbose(CALL_INFO, 1, 0, "%s: ports=%u arrays=%u arbitration=%s grants/cycle=%u\n",
+                    getName().c_str(), numPorts, numArrays, arb.c_str(), grantsPerCycle);
+    }
+
+    ~SharedAnalogTile() override {
+        for (auto& q : portQ) {
+            for (auto* ev : q) delete ev;
+            q.clear();
+        }
+        for (auto* ev : computePending) delete ev;
+    }
+
+    void init(unsigned int phase) override {
+        array->init(phase);
+        if (phase == 0) {
+            arrayBusy.assign(numArrays, false);
+            computeOwner.assign(numArrays, 0);
+            computePending.assign(numArrays, nullptr);
+        }
+    }
+
+    void setup()  override { array->setup(); }
+    void finish() override { array->finish(); }
+
+    // ---- Front-end requests ----
+    void handlePortEvent(Event* ev, uint32_t port) {
+        auto* tev = static_cast<TileEvent*>(ev);
+        stat_port_requests[port]->addData(1);
+        portQ[port].push_back(tev);
+        wakeClock();
+    }
+
+    // ---- Array completion ----
+    void handleArrayEvent(Event* ev) {
+        auto* aev = static_cast<SST::Golem::ArrayEvent*>(ev);
+        const uint32_t aid = aev->getArrayID();
+        delete ev;
+
+        if (aid >= arrayBusy.size() || !arrayBusy[aid]) {
+            out.verbose(CALL_INFO, 0, 0, "%s: unexpected completion for array %u\n",
+                        getName().c_str(), aid);
+            return;
+        }
+        arrayBusy[aid] = false;
+
+        TileEvent* done = computePending[aid];
+        computePending[aid] = nullptr;
+        if (done->op == TileOp::MatMat) {
+            const T* ys = static_cast<const T*>(arrayOps->getBatchOutput(aid));
+            const size_t n = static_cast<size_t>(done->arg) * arrayOutputSize;
+            done->payload.assign(n * outputOperandSize, 0);
+            for (size_t i = 0; i < n; ++i) {
+                std::memcpy(&done->payload[i * outputOperandSize], &ys[i], outputOperandSize);
+            }
+        }
+        ports[computeOwner[aid]]->send(done);
+
+        // A blocked head-of-queue command may now be eligible
+        wakeClock();
+    }
+
+private:
+    enum class Arbitration { RoundRobin, Priority };
+
+    bool tick(Cycle_t /*cycle*/) {
+        uint32_t eligible = 0;
+        uint32_t blocked  = 0;
+        for (uint32_t p = 0; p < numPorts; ++p) {
+            if (portQ[p].empty()) continue;
+            if (isEligible(portQ[p].front())) ++eligible;
+            else                              ++blocked;
+        }
+
+        uint32_t granted = 0;
+        const uint32_t start = rrNext;
+        for (uint32_t n = 0; n < numPorts && granted < grantsPerCycle; ++n) {
+            const uint32_t p = (policy == Arbitration::RoundRobin)
+                ? (start + n) % numPorts
+                : priorityOrder[n];
+            if (portQ[p].empty() || !isEligible(portQ[p].front())) continue;
+
+            TileEvent* tev = portQ[p].front();
+            portQ[p].pop_front();
+            service(p, tev);
+            ++granted;
+
+            if (policy == Arbitration::RoundRobin) rrNext = (p + 1) % numPorts;
+        }
+
+        // Contention accounting: anyone still waiting at a queue head lost a cycle
+        if (granted) stat_grants->addData(granted);
+        if (eligible > granted) stat_arb_conflicts->addData(eligible - granted);
+        if (blocked) stat_array_conflicts->addData(blocked);
+        bool pending = false;
+        for (uint32_t p = 0; p < numPorts; ++p) {
+            if (portQ[p].empty()) continue;
+            stat_port_wait[p]->addData(1);
+            pending = true;
+        }
+
+        // Go idle until the next request or array completion
+        if (!pending) clockOn = false;
+        return !pending;
+    }
+
+    void wakeClock() {
+        if (clockOn) return;
+        clockOn = true;
+        reregisterClock(clockTC, clockHandler);
+    }
+
+    bool isEligible(const TileEvent* tev) const {
+        if (tev->arrayID >= numArrays) return true; // fails fast in service()
+        if (arrayBusy[tev->arrayID]) return false;
+        if (tev->op == TileOp::Move && tev->aux < numArrays && arrayBusy[tev->aux]) return false;
+        if (tev->op == TileOp::LoadBcast) {
+            for (uint32_t a = 0; a < numArrays && a < 64; ++a) {
+                if (((tev->arg >> a) & 1) && arrayBusy[a]) return false;
+            }
+        }
+        return true;
+    }
+
+    void service(uint32_t port, TileEvent* tev) {
+        const uint32_t aid = tev->arrayID;
+        if (aid >= numArrays || (tev->op == TileOp::Move && tev->aux >= numArrays)) {
+            out.verbose(CALL_INFO, 0, 0, "%s: port%u array %u out of range (numArrays=%u)\n",
+                        getName().c_str(), port, aid, numArrays);
+            tev->status = 1;
+            tev->payload.clear();
+            ports[port]->send(tev);
+            return;
+        }
+
+        switch (tev->op) {
+            case TileOp::SetMatrix:
+                for (size_t i = 0; i + inputOperandSize <= tev->payload.size(); i += inputOperandSize) {
+                    T v{};
+                    std::memcpy(&v, &tev->payload[i], inputOperandSize);
+                    array->setMatrixItem(aid, static_cast<int>(i / inputOperandSize), v);
+                }
+                break;
+
+            case TileOp::LoadVec:
+                for (size_t i = 0; i + inputOperandSize <= tev->payload.size(); i += inputOperandSize) {
+                    T v{};
+                    std::memcpy(&v, &tev->payload[i], inputOperandSize);
+                    array->setVectorItem(aid, static_cast<int>(i / inputOperandSize), v);
+                }
+                break;
+
+            case TileOp::LoadBcast: {
+                const size_t n = arrayInputSize;
+                if (tev->payload.size() < n * inputOperandSize) {
+                    tev->status = 1;
+                    tev->payload.clear();
+                    ports[port]->send(tev);
+                    return;
+                }
+                std::vector<T> x(n);
+                for (size_t i = 0; i < n; ++i) {
+                    std::memcpy(&x[i], &tev->payload[i * inputOperandSize], inputOperandSize);
+                }
+                if (arrayOps) {
+                    arrayOps->setVectorBlock(tev->arg, arrayInputSize, x.data());
+                } else {
+                    for (uint32_t a = 0; a < numArrays && a < 64; ++a) {
+                        if (!((tev->arg >> a) & 1)) continue;
+                        for (uint32_t i = 0; i < arrayInputSize; ++i) array->setVectorItem(a, i, x[i]);
+                    }
+                }
+                break;
+            }
+
+            case TileOp::Free:
+                if (!arrayOps) {
+                    tev->status = 1;
+                    ports[port]->send(tev);
+                    return;
+                }
+                arrayOps->freeArray(aid);
+                break;
+
+            case TileOp::Compute:
+            case TileOp::ComputeT:
+                if (tev->op == TileOp::ComputeT && !arrayOps) {
+                    tev->status = 1;
+                    ports[port]->send(tev);
+                    return;
+                }
+                arrayBusy[aid]      = true;
+                computeOwner[aid]   = port;
+                computePending[aid] = tev;
+                tev->status         = 0;
+                // reply from handleArrayEvent
+                if (tev->op == TileOp::ComputeT) arrayOps->beginTransposeComputation(aid);
+                else                             array->beginComputation(aid);
+                return;
+
+            case TileOp::MatMat: {
+                const size_t n = static_cast<size_t>(tev->arg) * arrayInputSize;
+                if (!arrayOps || tev->arg == 0 || tev->payload.size() < n * inputOperandSize) {
+                    tev->status = 1;
+                    tev->payload.clear();
+                    ports[port]->send(tev);
+                    return;
+                }
+                std::vector<T> xs(n);
+                for (size_t i = 0; i < n; ++i) {
+                    std::memcpy(&xs[i], &tev->payload[i * inputOperandSize], inputOperandSize);
+                }
+                tev->payload.clear();
+                arrayBusy[aid]      = true;
+                computeOwner[aid]   = port;
+                computePending[aid] = tev;
+                tev->status         = 0;
+                arrayOps->beginBatchComputation(aid, static_cast<uint32_t>(tev->arg), xs.data());
+                return;
+            }
+
+            case TileOp::StoreVec: {
+                auto& outVec = *static_cast<std::vector<T>*>(array->getOutputVector(aid));
+                // Forward MVMs leave arrayOutputSize entries, mvm.t leaves arrayInputSize
+                tev->payload.assign(outVec.size() * outputOperandSize, 0);
+                for (size_t i = 0; i < outVec.size(); ++i) {
+                    T v = outVec[i];
+                    std::memcpy(&tev->payload[i * outputOperandSize], &v, outputOperandSize);
+                }
+                tev->status = 0;
+                ports[port]->send(tev);
+                return;
+            }
+
+            case TileOp::Move:
+                array->moveOutputToInput(aid, tev->aux);
+                break;
+
+            case TileOp::RemoteVec: {
+                // mvm.mv.remote from another core: output encoding, only the
+                // first min(rows, cols) entries fit the input buffer
+                const size_t n = std::min<size_t>({ tev->payload.size() / outputOperandSize,
+                                                    arrayOutputSize, arrayInputSize });
+                for (size_t i = 0; i < n; ++i) {
+                    T v{};
+                    std::memcpy(&v, &tev->payload[i * outputOperandSize], outputOperandSize);
+                    array->setVectorItem(aid, static_cast<int>(i), v);
+                }
+                break;
+            }
+
+            case TileOp::SetRegion: {
+                const MatrixRegion r = MatrixRegion::region(tev->arg);
+                if (!arrayOps || !r.fits(arrayOutputSize, arrayInputSize) ||
+                    tev->payload.size() < r.cells() * inputOperandSize) {
+                    tev->status = 1;
+                    tev->payload.clear();
+                    ports[port]->send(tev);
+                    return;
+                }
+                std::vector<T> block(r.cells());
+                for (size_t i = 0; i < block.size(); ++i) {
+                    std::memcpy(&block[i], &tev->payload[i * inputOperandSize], inputOperandSize);
+                }
+                arrayOps->setMatrixRegion(aid, r.row0, r.nrows, r.col0, r.ncols, block.data());
+                break;
+            }
+
+            default: // RemoteAck never arrives on a tile port
+                tev->status = 1;
+                tev->payload.clear();
+                ports[port]->send(tev);
+                return;
+        }
+
+        tev->status = 0;
+        tev->payload.clear();
+        ports[port]->send(tev);
+    }
+
+private:
+    SST::Output out;
+
+    // Subcomponents / links
+    SST::Golem::ComputeArray* array {nullptr};
+    AnalogArrayOps*           arrayOps {nullptr};
+    std::vector<SST::Link*>   ports;
+
+    SST::Clock::HandlerBase* clockHandler {nullptr};
+    TimeConverter*           clockTC {nullptr};
+    bool                     clockOn {true};
+
+    // Params / sizes
+    uint32_t numPorts{1};
+    uint32_t numArrays{1};
+    uint32_t inputOperandSize{4};
+    uint32_t outputOperandSize{4};
+    uint32_t arrayInputSize{2};
+    uint32_t arrayOutputSize{2};
+    uint32_t grantsPerCycle{1};
+
+    // Arbitration
+    Arbitration           policy{Arbitration::RoundRobin};
+    uint32_t              rrNext{0};
+    std::vector<uint32_t> priorityOrder;
+
+    // Per-port command queues
+    std::vector<std::deque<TileEvent*>> portQ;
+
+    // Array bookkeeping
+    std::vector<bool>       arrayBusy;
+    std::vector<uint32_t>   computeOwner;
+    std::vector<TileEvent*> computePending;
+
+    // Statistics
+    Statistic<uint64_t>*              stat_grants {nullptr};
+    Statistic<uint64_t>*              stat_arb_conflicts {nullptr};
+    Statistic<uint64_t>*              stat_array_conflicts {nullptr};
+    std::vector<Statistic<uint64_t>*> stat_port_requests;
+    std::vector<Statistic<uint64_t>*> stat_port_wait;
+};
+
+// ---- Registered element types ----
+class SharedAnalogTileFloat : public SharedAnalogTile<float> {
+public:
+    SST_ELI_REGISTER_COMPONENT(
+        SharedAnalogTileFloat,
+        "golem",
+        "SharedAnalogTileFloat",
+        SST_ELI_ELEMENT_VERSION(1, 0, 0),
+        "Analog array pool shared by several RoCCAnalog front-ends (float)",
+        COMPONENT_CATEGORY_PROCESSOR
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"clock",             "Arbitration clock", "1GHz"},
+        {"verbose",           "Verbosity", "0"},
+        {"numPorts",          "Number of RoCC front-end ports", "1"},
+        {"numArrays",         "Arrays in the shared pool (must match the array subcomponent)", "1"},
+        {"arrayInputSize",    "Input vector length (mvm.set.region bounds)", "2"},
+        {"arrayOutputSize",   "Output vector length", "2"},
+        {"inputOperandSize",  "Bytes per input element", "4"},
+        {"outputOperandSize", "Bytes per output element", "4"},
+        {"arbitration",       "roundrobin | priority", "roundrobin"},
+        {"portPriority",      "Per-port priority, lower wins (priority arbitration)", "port index"},
+        {"grantsPerCycle",    "Commands granted per cycle across all ports", "1"}
+    )
+
+    SST_ELI_DOCUMENT_PORTS(
+        {"port%(numPorts)d", "Link to a core's RoCCAnalog 'tile' port", {"SST::Golem::TileEvent"}}
+    )
+
+    SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        {"array", "Shared compute array pool", "SST::Golem::ComputeArray"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        {"grants",           "Commands granted", "commands", 1},
+        {"arb_conflicts",    "Eligible commands that lost arbitration, summed per cycle", "commands", 1},
+        {"array_conflicts",  "Queue heads blocked on a busy array, summed per cycle", "commands", 1},
+        {"port_requests",    "Commands received per port", "commands", 1},
+        {"port_wait_cycles", "Cycles a port had a command waiting", "cycles", 1}
+    )
+
+    SharedAnalogTileFloat(ComponentId_t id, Params& params)
+        : SharedAnalogTile<float>(id, params) {}
+};
+
+} // namespace Golem
+} // namespace SST
+
+#endif // _H_ANALOG_SHARED_TILE